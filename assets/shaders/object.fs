@@ -6,17 +6,28 @@ in vec3 FragPos;         // Fragment position in world space
 in vec3 Normal;          // Normal vector at the fragment
 in vec2 TexCoords;       // Texture coordinates
 in vec3 VertexColor;     // Vertex color passed from the vertex shader
+in vec3 InstanceTint;    // Per-instance tint, white when not instanced
 
 // Global
 uniform sampler2D texture1;                      // Texture sampler
-uniform vec3 viewPos;                            // Position of the camera/viewer
 
-uniform int lightType = 0;                       // 0: Directional light, 1: Point light (TBD 2: Spotlight)
-uniform vec3 lightColor = vec3(1.0, 1.0, 1.0);   // Color of the light source
-uniform vec3 lightPos = vec3(0.0, -1.0, 0.0);    // (point light pos or directional light dir)
+// Per frame, set by ObjectShader::setGlobalRenderParams and setLight (FrameUniforms). Must match object.vs.
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;                               // Position of the camera/viewer
+    vec4 lightColor;                            // Color of the light source
+    vec4 lightPos;                              // Point light pos or directional light dir
+    int lightType;                              // 0: Directional light, 1: Point light (TBD 2: Spotlight)
+};
+
+// Per object, set by ObjectShader::setObjectRenderParams (ObjectUniforms). Must match object.vs.
+layout (std140) uniform ObjectData {
+    mat4 model;
+    mat4 normalMatrix;                          // Upper 3x3 is transpose(inverse(model))
+    vec4 tint;                                  // Tint color for additional coloring
+};
 
-// Per Object
-uniform vec3 tint = vec3(-1.0, -1.0, -1.0);         // Tint color for additional coloring
 // uniform vec2 textureScale = vec2(1.0, 1.0);      // Scale for texture repetition
 
 void main()
@@ -27,7 +38,7 @@ void main()
     float specularStrength = 0.1;               // Shiny/metallic reflection
 
     // Ambient lighting
-    vec3 ambient = ambientStrength * lightColor;
+    vec3 ambient = ambientStrength * lightColor.rgb;
 
     // Default values
     vec3 norm = normalize(Normal);              // Ensure normal is normalized
@@ -37,23 +48,23 @@ void main()
     // Light type handling
     if (lightType == 0) {
         // Directional light: Use lightPos as a normalized direction
-        lightDir = normalize(lightPos);
+        lightDir = normalize(lightPos.xyz);
     } else if (lightType == 1) {
         // Point light: Use lightPos as a world-space position
-        lightDir = normalize(lightPos - FragPos);
-        float distance = length(lightPos - FragPos); // Distance to the light source
+        lightDir = normalize(lightPos.xyz - FragPos);
+        float distance = length(lightPos.xyz - FragPos); // Distance to the light source
         attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance); // Attenuation formula
     }
 
     // Diffuse lighting
     float diff = max(dot(norm, lightDir), 0.0) * diffStrength;
-    vec3 diffuse = attenuation * diff * lightColor;
+    vec3 diffuse = attenuation * diff * lightColor.rgb;
 
     // Specular lighting
-    vec3 viewDir = normalize(viewPos - FragPos); // Direction from fragment to the camera
+    vec3 viewDir = normalize(viewPos.xyz - FragPos); // Direction from fragment to the camera
     vec3 reflectDir = reflect(-lightDir, norm);  // Reflection vector for specular highlights
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32); // Specular component (higher power = sharper highlights)
-    vec3 specular = attenuation * specularStrength * spec * lightColor;
+    vec3 specular = attenuation * specularStrength * spec * lightColor.rgb;
 
     // Combine ambient, diffuse, and specular lighting
     vec3 lighting = ambient + diffuse + specular;
@@ -61,7 +72,7 @@ void main()
     vec4 texColor = texture(texture1, TexCoords);
 
     // Texture, vertex, and tinting can all affect the final color
-    vec3 colorEffect = texColor.rgb * VertexColor * tint;
+    vec3 colorEffect = texColor.rgb * VertexColor * tint.rgb * InstanceTint;
 
     // Apply lighting to the combined color effect
     vec3 result = lighting * colorEffect;
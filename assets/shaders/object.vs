@@ -6,23 +6,87 @@ layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoords;
 layout (location = 3) in vec3 aColor;
 
-// Global
-uniform mat4 projection;
-uniform mat4 view;
+// Per instance, only read when instanced is set (locations 4-7 hold the model matrix columns)
+layout (location = 4) in mat4 aInstanceModel;
+layout (location = 8) in vec3 aInstanceTint;
 
-// Per Object
-uniform mat4 model;
+// Per frame, set by ObjectShader::setGlobalRenderParams and setLight (FrameUniforms). Must match object.fs.
+layout (std140) uniform FrameData {
+    mat4 view;
+    mat4 projection;
+    vec4 viewPos;                               // Position of the camera/viewer
+    vec4 lightColor;                            // Color of the light source
+    vec4 lightPos;                              // Point light pos or directional light dir
+    int lightType;                              // 0: Directional light, 1: Point light (TBD 2: Spotlight)
+};
+
+// Per object, set by ObjectShader::setObjectRenderParams (ObjectUniforms). Must match object.fs.
+layout (std140) uniform ObjectData {
+    mat4 model;
+    mat4 normalMatrix;                          // Upper 3x3 is transpose(inverse(model))
+    vec4 tint;                                  // Tint color for additional coloring
+};
+
+uniform bool instanced = false;
+
+// Procedural stadium surface. Vertex 0 is the center, then stadiumVerticesPerRing vertices for each ring from the
+// inside out; the attributes are not read.
+uniform bool stadiumSurface = false;
+uniform float stadiumRadius;
+uniform float stadiumCurvature;         // y = stadiumCurvature * r^2
+uniform int stadiumVerticesPerRing;
+uniform int stadiumNumRings;
+uniform float stadiumTextureScale;
+uniform vec3 stadiumRingColor;
+uniform vec3 stadiumCrossColor;
+uniform vec3 stadiumBaseColor;
 
 out vec3 FragPos;
 out vec3 Normal;
 out vec2 TexCoords;
 out vec3 VertexColor;
+out vec3 InstanceTint;
+
+void stadiumVertex(out vec3 position, out vec3 normal, out vec2 texCoords, out vec3 color)
+{
+    int ring = 0;
+    int spoke = 0;
+    if (gl_VertexID > 0) {
+        ring = (gl_VertexID - 1) / stadiumVerticesPerRing + 1;
+        spoke = (gl_VertexID - 1) % stadiumVerticesPerRing;
+    }
+
+    // Rings are spaced by the square root so the triangles have similar areas
+    float theta = 6.28318530718 * float(spoke) / float(stadiumVerticesPerRing);
+    vec2 unit = sqrt(float(ring) / float(stadiumNumRings)) * vec2(cos(theta), sin(theta));
+    vec2 xz = stadiumRadius * unit;
+
+    position = vec3(xz.x, stadiumCurvature * dot(xz, xz), xz.y);
+    normal = normalize(vec3(2.0 * stadiumCurvature * xz.x, -1.0, 2.0 * stadiumCurvature * xz.y));     // Same side as the triangle winding
+    texCoords = stadiumTextureScale * unit + 0.5;
+
+    // Ring color for middle and end, cross color along the axes
+    int n = stadiumVerticesPerRing;
+    if (ring == 0) color = stadiumCrossColor;
+    else if (ring == stadiumNumRings / 4 || ring == stadiumNumRings - 1) color = stadiumRingColor;
+    else if (spoke == 0 || spoke == n / 4 || spoke == n / 2 || spoke == 3 * n / 4) color = stadiumCrossColor;
+    else color = stadiumBaseColor;
+}
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
-    TexCoords = aTexCoords;
-    VertexColor = aColor;
+    vec3 position = aPos;
+    vec3 normal = aNormal;
+    vec2 texCoords = aTexCoords;
+    vec3 color = aColor;
+    if (stadiumSurface) stadiumVertex(position, normal, texCoords, color);
+
+    // Instance models are rigid (see InstanceData), so their upper 3x3 serves as the normal matrix
+    mat4 objectModel = instanced ? aInstanceModel : model;
+    FragPos = vec3(objectModel * vec4(position, 1.0));
+    Normal = (instanced ? mat3(aInstanceModel) : mat3(normalMatrix)) * normal;
+    TexCoords = texCoords;
+    VertexColor = color;
+    InstanceTint = instanced ? aInstanceTint : vec3(1.0);
     gl_Position = projection * view * vec4(FragPos, 1.0);
 }
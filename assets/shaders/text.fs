@@ -1,11 +1,11 @@
 #version 330 core
 in vec2 TexCoords;
+in vec4 TextColor;
 out vec4 color;
 
-uniform sampler2D text;
-uniform vec3 textColor;
+uniform sampler2D text;     // Glyph atlas, coverage in the red channel
 
 void main() {
     vec4 sampled = vec4(1.0, 1.0, 1.0, texture(text, TexCoords).r);
-    color = vec4(textColor, 1.0) * sampled;
+    color = TextColor * sampled;
 }
@@ -1,10 +1,14 @@
 #version 330 core
-layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>
+layout (location = 0) in vec4 vertex; // <vec2 pos, vec2 tex>, tex in atlas texels
+layout (location = 1) in vec4 vertexColor;
 out vec2 TexCoords;
+out vec4 TextColor;
 
 uniform mat4 projection;
+uniform sampler2D text;     // Glyph atlas; it can grow between addText() and flush(), so normalise here
 
 void main() {
     gl_Position = projection * vec4(vertex.xy, 0.0, 1.0);
-    TexCoords = vertex.zw;
+    TexCoords = vertex.zw / vec2(textureSize(text, 0));
+    TextColor = vertexColor;
 }
@@ -3,69 +3,267 @@
 // Copyright (c) 2024 Ricky Zhang
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
 #include <GL/glew.h>
 #include "Buffers.h"
 
+const std::vector<VertexAttribute> PACKED_VERTEX_LAYOUT = {
+    { 3, VertexComponent::FLOAT, false },           // Position
+    { 4, VertexComponent::INT_2_10_10_10, true },   // Normal, w unused
+    { 2, VertexComponent::HALF_FLOAT, false },      // Texture coordinates
+    { 4, VertexComponent::UNSIGNED_BYTE, true }     // Color, alpha unused
+};
+
+/**
+* Convert to IEEE half precision, rounding to nearest. Values too small for a normal half become zero and values
+* too large become infinity, neither of which matters for texture coordinates.
+*/
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+
+    uint16_t sign = uint16_t((bits >> 16) & 0x8000);
+    int exponent = int((bits >> 23) & 0xFF) - 127 + 15;
+    uint32_t mantissa = bits & 0x7FFFFF;
+
+    if (exponent <= 0) return sign;
+    if (exponent >= 31) return uint16_t(sign | 0x7C00);
+
+    uint16_t half = uint16_t(sign | (exponent << 10) | (mantissa >> 13));
+    if (mantissa & 0x1000) ++half;      // A carry out of the mantissa correctly bumps the exponent
+    return half;
+}
+
+/**
+* Pack one vertex into the PACKED_VERTEX_LAYOUT format.
+*
+* @param position               [in] Position.
+*
+* @param normal                 [in] Unit normal.
+*
+* @param texCoord               [in] Texture coordinates.
+*
+* @param color                  [in] Color, clamped to [0, 1].
+*/
+
+PackedVertex packVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& texCoord, const glm::vec3& color) {
+    PackedVertex vertex;
+    vertex.position[0] = position.x;
+    vertex.position[1] = position.y;
+    vertex.position[2] = position.z;
+    vertex.normal = packNormal(normal);
+    vertex.texCoord[0] = floatToHalf(texCoord.x);
+    vertex.texCoord[1] = floatToHalf(texCoord.y);
+    uint32_t packedColor = packColor(color);
+    memcpy(vertex.color, &packedColor, sizeof(vertex.color));
+    return vertex;
+}
+
+/**
+* Pack a unit normal as GL_INT_2_10_10_10_REV: x in the low 10 bits, then y and z.
+*/
+
+uint32_t packNormal(const glm::vec3& normal) {
+    uint32_t packed = 0;
+    for (int i = 0; i < 3; ++i) {
+        int component = int(std::lround(std::clamp(normal[i], -1.0f, 1.0f) * 511.0f));
+        packed |= (uint32_t(component) & 0x3FF) << (10 * i);
+    }
+    return packed;
+}
+
+/**
+* Pack a color as RGBA8 with opaque alpha, in memory order, so it can be copied straight into a vertex.
+*/
+
+uint32_t packColor(const glm::vec3& color) {
+    uint8_t bytes[4];
+    for (int i = 0; i < 3; ++i) {
+        bytes[i] = uint8_t(std::lround(std::clamp(color[i], 0.0f, 1.0f) * 255.0f));
+    }
+    bytes[3] = 255;
+    uint32_t packed;
+    memcpy(&packed, bytes, sizeof(packed));
+    return packed;
+}
+
 /**
 * Set up the vertex data and indices.  This variation requires that colors be embedded
 * in the vertex data.
 * 
 * Refer to OpenGL documentation for detailed descriptions of the various objects.
 * 
-* @param 
-[in] OpenGL Vertex Array Object
+* @param VAO                    [in/out] OpenGL Vertex Array Object, created if 0.
 * 
-* @param VBO                    [in] OpenGL Vertex Buffer Object.
+* @param VBO                    [in/out] OpenGL Vertex Buffer Object, created if 0.
 * 
-* @param EBO                    [in] OpenGL Element Buffer Object.
+* @param EBO                    [in/out] OpenGL Element Buffer Object, created if 0.
 * 
-* @param vertices               [in] Vertices.
+* @param vertices               [in] Interleaved vertex data.
 * 
-* @param verticesSize           [in] Number of vertices.
+* @param verticesSize           [in] Size of the vertex data in bytes.
 * 
 * @param indices                [in] Vertex indices.
 * 
-* @param indicesSize            [in] Number of vertex indices.
+* @param indicesSize            [in] Size of the indices in bytes.
+* 
+* @param layout                 [in] Vertex attributes, in location order.
 */
 
 void setupBuffers(
     unsigned int& VAO,
     unsigned int& VBO,
     unsigned int& EBO,
-    const float* vertices,
+    const void* vertices,
     size_t verticesSize,
     const unsigned int* indices,
     size_t indicesSize,
-    const std::vector<int>& attributeSizes
+    const std::vector<VertexAttribute>& layout
 ) {
-    // ERRORS
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
+    if (VAO == 0) glGenVertexArrays(1, &VAO);
+
+    setupVertexStream(VAO, VBO, vertices, verticesSize, layout, 0);
+
+    // The element buffer binding is part of the VAO
+    glBindVertexArray(VAO);
+    updateBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO, indices, indicesSize);
+    glBindVertexArray(0);
+}
+
+/**
+* Fill a buffer holding some of a VAO's attributes and point the attributes at it.
+*
+* @param VAO                    [in] Vertex array the attributes belong to.
+*
+* @param VBO                    [in/out] Buffer for these attributes, created if 0.
+*
+* @param data                   [in] Interleaved attribute data.
+*
+* @param size                   [in] Size of the data in bytes.
+*
+* @param layout                 [in] Attributes in the buffer, in location order.
+*
+* @param firstLocation          [in] Location of the first attribute.
+*/
 
+void setupVertexStream(
+    unsigned int VAO,
+    unsigned int& VBO,
+    const void* data,
+    size_t size,
+    const std::vector<VertexAttribute>& layout,
+    unsigned int firstLocation
+) {
     glBindVertexArray(VAO);
+    updateBuffer(GL_ARRAY_BUFFER, VBO, data, size);
+    bindVertexAttributes(VBO, 0, layout, firstLocation);
+    glBindVertexArray(0);
+}
 
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, verticesSize, vertices, GL_STATIC_DRAW);
+/**
+* Point attributes of the bound VAO at interleaved data already in a buffer, e.g. a StreamBuffer slice.
+*
+* @param buffer                 [in] Buffer holding the data. Left bound to GL_ARRAY_BUFFER.
+*
+* @param offset                 [in] Byte offset of the first vertex.
+*
+* @param layout                 [in] Attributes in the buffer, in location order.
+*
+* @param firstLocation          [in] Location of the first attribute.
+*/
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, indices, GL_STATIC_DRAW);
+void bindVertexAttributes(unsigned int buffer, size_t offset, const std::vector<VertexAttribute>& layout, unsigned int firstLocation) {
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
 
-    // Calculate stride
+    // GL type and size in bytes of each attribute
+    std::vector<GLenum> types(layout.size());
+    std::vector<int> sizes(layout.size());
     int stride = 0;
-    for (int size : attributeSizes) {
-        stride += size;
+    for (size_t i = 0; i < layout.size(); ++i) {
+        switch (layout[i].type) {
+        case VertexComponent::FLOAT:
+            types[i] = GL_FLOAT;
+            sizes[i] = layout[i].size * int(sizeof(float));
+            break;
+        case VertexComponent::HALF_FLOAT:
+            types[i] = GL_HALF_FLOAT;
+            sizes[i] = layout[i].size * int(sizeof(uint16_t));
+            break;
+        case VertexComponent::INT_2_10_10_10:
+            types[i] = GL_INT_2_10_10_10_REV;
+            sizes[i] = int(sizeof(uint32_t));
+            break;
+        case VertexComponent::UNSIGNED_BYTE:
+            types[i] = GL_UNSIGNED_BYTE;
+            sizes[i] = layout[i].size;
+            break;
+        }
+        stride += sizes[i];
     }
-    stride *= sizeof(float);
 
     // Set attributes
-    uintptr_t offset = 0;
-    for (size_t i = 0; i < attributeSizes.size(); ++i) {
-        GLuint index = static_cast<GLuint>(i);
-        glVertexAttribPointer(index, attributeSizes[i], GL_FLOAT, GL_FALSE, stride, (void*)offset);
+    for (size_t i = 0; i < layout.size(); ++i) {
+        GLuint index = static_cast<GLuint>(firstLocation + i);
+        glVertexAttribPointer(index, layout[i].size, types[i], layout[i].normalized ? GL_TRUE : GL_FALSE, stride, (void*)offset);
         glEnableVertexAttribArray(index);
-        offset += attributeSizes[i] * sizeof(float);
+        offset += sizes[i];
     }
+}
 
-    glBindVertexArray(0);
-}
\ No newline at end of file
+/**
+* Replace the contents of a buffer, leaving it bound. A new buffer is sized exactly. After that, data that fits is
+* written in place; otherwise the buffer grows by at least half so a mesh that keeps growing reallocates only a few
+* times.
+*
+* @param target                 [in] Binding point, e.g. GL_ARRAY_BUFFER.
+*
+* @param buffer                 [in/out] Buffer, created if 0.
+*
+* @param data                   [in] New contents.
+*
+* @param size                   [in] Size of the data in bytes.
+*/
+
+void updateBuffer(unsigned int target, unsigned int& buffer, const void* data, size_t size) {
+    if (buffer == 0) glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+
+    GLint capacity = 0;
+    glGetBufferParameteriv(target, GL_BUFFER_SIZE, &capacity);
+    if (capacity == 0) {
+        glBufferData(target, size, data, GL_STATIC_DRAW);
+        return;
+    }
+    if (size > size_t(capacity)) {
+        size_t grown = std::max(size, size_t(capacity) + size_t(capacity) / 2);
+        glBufferData(target, grown, nullptr, GL_DYNAMIC_DRAW);
+    }
+    if (size > 0) glBufferSubData(target, 0, size, data);
+}
+
+/**
+* Set up buffers for vertex data made only of floats.
+*
+* @param attributeSizes         [in] Floats in each attribute, in location order.
+*/
+
+void setupBuffers(
+    unsigned int& VAO,
+    unsigned int& VBO,
+    unsigned int& EBO,
+    const float* vertices,
+    size_t verticesSize,
+    const unsigned int* indices,
+    size_t indicesSize,
+    const std::vector<int>& attributeSizes
+) {
+    std::vector<VertexAttribute> layout;
+    for (int size : attributeSizes) {
+        layout.push_back({ size, VertexComponent::FLOAT, false });
+    }
+    setupBuffers(VAO, VBO, EBO, static_cast<const void*>(vertices), verticesSize, indices, indicesSize, layout);
+}
@@ -5,8 +5,73 @@
 
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
+#include <glm/glm.hpp>
+
+// How one component of a vertex attribute is stored
+enum class VertexComponent {
+    FLOAT,
+    HALF_FLOAT,
+    INT_2_10_10_10,         // Signed 10:10:10:2 packed into 4 bytes; size must be 4
+    UNSIGNED_BYTE
+};
+
+// One vertex attribute. Attributes are bound to locations 0, 1, 2... in order and are tightly packed.
+struct VertexAttribute {
+    int size;               // Components, 1 to 4
+    VertexComponent type;
+    bool normalized;        // Integer types are read as [0, 1] (unsigned) or [-1, 1] (signed) instead of as integers
+};
+
+/**
+* Compact vertex used by all MeshObjects and BeybladeMesh: float position, 10:10:10 normal, half float texture
+* coordinates and RGBA8 color. 24 bytes instead of 44 for the same four attributes as floats, and read by the
+* object shader unchanged.
+*/
+struct PackedVertex {
+    float position[3];
+    uint32_t normal;
+    uint16_t texCoord[2];
+    uint8_t color[4];
+};
+static_assert(sizeof(PackedVertex) == 24, "PackedVertex must be tightly packed");
+
+extern const std::vector<VertexAttribute> PACKED_VERTEX_LAYOUT;
+
+PackedVertex packVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& texCoord, const glm::vec3& color);
+uint32_t packNormal(const glm::vec3& normal);
+uint32_t packColor(const glm::vec3& color);
+uint16_t floatToHalf(float value);
+
+/**
+* GL objects passed in as 0 are created. Existing ones are kept and refilled, with glBufferSubData when the data
+* fits, so meshes that are rebuilt (e.g. the stadium while it is being customized) do not leak or reallocate.
+*/
+void setupBuffers(
+    unsigned int& VAO,
+    unsigned int& VBO,
+    unsigned int& EBO,
+    const void* vertices,
+    size_t verticesSize,
+    const unsigned int* indices,
+    size_t indicesSize,
+    const std::vector<VertexAttribute>& layout
+);
+
+// Attributes kept in their own buffer so they can be replaced without touching the rest of the vertex data
+void setupVertexStream(
+    unsigned int VAO,
+    unsigned int& VBO,
+    const void* data,
+    size_t size,
+    const std::vector<VertexAttribute>& layout,
+    unsigned int firstLocation
+);
+void bindVertexAttributes(unsigned int buffer, size_t offset, const std::vector<VertexAttribute>& layout, unsigned int firstLocation);
+void updateBuffer(unsigned int target, unsigned int& buffer, const void* data, size_t size);
+
 // 12/24/24: ONLY NEED 1 call, pass in sizes of attributes
 void setupBuffers(
     unsigned int& VAO,
@@ -7,6 +7,7 @@
 
 #include "InputUtils.h"
 #include "PhysicsWorld.h"
+#include "PhysicsSnapshot.h"
 #include "InputManager.h"
 
 using namespace glm;
@@ -65,6 +66,12 @@ vec3 Camera::applyCollisions(const vec3& currPos, vec3& nextPos) const {
     }
 
     for (const Stadium* stadium : physicsWorld->getStadiums()) {
+        // Moving down onto the surface stops just above it. Coming up from underneath is handled below.
+        TriangleBVH::Hit hit;
+        if (stadium->raycast(currPos, nextPos - currPos, 1.0f, hit) && hit.normal.y > 0.0f) {
+            nextPos = hit.point + hit.normal * 0.01f;
+        }
+
         if (stadium->isInside(M(nextPos.x), M(nextPos.z))) {
             float surfaceY = (stadium->getY(M(nextPos.x), M(nextPos.z)).value());
             if (nextPos.y < surfaceY) {
@@ -85,6 +92,13 @@ void Camera::update(float deltaTime) {
         if (followingBey == nullptr) {
             std::cout << "Uninitialized Bey" << std::endl;
         }
+        else if (snapshot != nullptr) {
+            const BodySnapshot* followed = snapshot->find(followingBey);
+            if (followed != nullptr) {
+                position = followed->center;
+                position.y += heightAbove;
+            }
+        }
         else {
             position = followingBey->getCenter().value();
             position.y += heightAbove;
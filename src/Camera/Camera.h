@@ -13,6 +13,7 @@ enum Action;
 class PhysicsWorld;
 class BeybladeBody;
 class Stadium;
+struct PhysicsSnapshot;
 class InputManager;
 
 /*
@@ -38,6 +39,7 @@ public:
 
     // Must call these before changing the mode (initial only works in free UNTIL attached to beybalde/stadium)
     void setFollowingBey(BeybladeBody* bey) { followingBey = bey; }
+    void setSnapshot(const PhysicsSnapshot* latest) { snapshot = latest; }  // Set while physics runs on its own thread
     void setPanningVariables(Stadium* stadium);
     void changeCameraMode(CameraMode newMode) { activeMode = newMode; }
 
@@ -106,6 +108,7 @@ private:
 
     // For attached
     BeybladeBody* followingBey{};
+    const PhysicsSnapshot* snapshot{};      // If set, followingBey is only used as a key into it
 
     // For panning
     float radius{};
@@ -5,23 +5,29 @@
 
 #pragma once
 
+// Model used by beyblades without a custom mesh
+#define DEFAULT_MODEL_PATH "./assets/models/default.obj"
+
+// Combined layer/disc/driver meshes of template beyblades, see MeshManager::getTemplateMesh()
+#define TEMPLATE_CACHE_DIR "./assets/models/templates"
+
 // Layer model paths
-#define LAYER_STANDARD_PATH "./assets/models/layers/layer_standard.obj"
-#define LAYER_WIDE_PATH "./assets/models/layers/layer_wide.obj"
-#define LAYER_TALL_PATH "./assets/models/layers/layer_tall.obj"
-#define LAYER_LIGHT_PATH "./assets/models/layers/layer_light.obj"
-#define LAYER_HEAVY_PATH "./assets/models/layers/layer_heavy.obj"
+#define LAYER_STANDARD_PATH "./assets/layers/layer_standard.obj"
+#define LAYER_WIDE_PATH "./assets/layers/layer_wide.obj"
+#define LAYER_TALL_PATH "./assets/layers/layer_tall.obj"
+#define LAYER_LIGHT_PATH "./assets/layers/layer_light.obj"
+#define LAYER_HEAVY_PATH "./assets/layers/layer_heavy.obj"
 
 // Disc model paths
-#define DISC_STANDARD_PATH "./assets/models/discs/disc_standard.obj"
-#define DISC_WIDE_PATH "./assets/models/discs/disc_wide.obj"
-#define DISC_HEAVY_PATH "./assets/models/discs/disc_heavy.obj"
-#define DISC_LIGHT_PATH "./assets/models/discs/disc_light.obj"
-#define DISC_COMPACT_PATH "./assets/models/discs/disc_compact.obj"
+#define DISC_STANDARD_PATH "./assets/discs/disc_standard.obj"
+#define DISC_WIDE_PATH "./assets/discs/disc_wide.obj"
+#define DISC_HEAVY_PATH "./assets/discs/disc_heavy.obj"
+#define DISC_LIGHT_PATH "./assets/discs/disc_light.obj"
+#define DISC_COMPACT_PATH "./assets/discs/disc_compact.obj"
 
 // Driver model paths
-#define DRIVER_STANDARD_PATH "./assets/models/drivers/driver_standard.obj"
-#define DRIVER_WIDE_PATH "./assets/models/drivers/driver_wide.obj"
-#define DRIVER_TALL_PATH "./assets/models/drivers/driver_tall.obj"
-#define DRIVER_LIGHT_PATH "./assets/models/drivers/driver_light.obj"
-#define DRIVER_HIGH_FRICTION_PATH "./assets/models/drivers/driver_high_friction.obj"
\ No newline at end of file
+#define DRIVER_STANDARD_PATH "./assets/drivers/driver_standard.obj"
+#define DRIVER_WIDE_PATH "./assets/drivers/driver_wide.obj"
+#define DRIVER_TALL_PATH "./assets/drivers/driver_tall.obj"
+#define DRIVER_LIGHT_PATH "./assets/drivers/driver_light.obj"
+#define DRIVER_HIGH_FRICTION_PATH "./assets/drivers/driver_high_friction.obj"
\ No newline at end of file
@@ -17,6 +17,8 @@ constexpr const char* PANORAMA_VERTEX_SHADER_PATH = "./assets/shaders/panorama.v
 constexpr const char* PANORAMA_FRAGMENT_SHADER_PATH = "./assets/shaders/panorama.fs";
 constexpr const char* FANCY_VERTEX_SHADER_PATH = "./assets/shaders/fancy.vs";
 constexpr const char* FANCY_FRAGMENT_SHADER_PATH = "./assets/shaders/fancy.fs";
+constexpr const char* DEBUG_VERTEX_SHADER_PATH = "./assets/shaders/debug.vs";
+constexpr const char* DEBUG_FRAGMENT_SHADER_PATH = "./assets/shaders/debug.fs";
 
 constexpr const char* DEFAULT_FONT_PATH = "./assets/fonts/Orbitron-Regular.ttf";
 constexpr const char* TITLE_FONT_PATH = "./assets/fonts/Orbitron-Bold.ttf";
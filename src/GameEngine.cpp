@@ -11,21 +11,26 @@
 
 #include "BeybladeConstants.h"
 #include "Camera.h"
+#include "DebugRenderer.h"
 #include "FontManager.h"
 #include "ImGuiUtils.h"
 #include "InputManager.h"
+#include "MeshManager.h"
 #include "Utils.h"
 #include "ImGuiUI.h"
 #include "MessageLog.h"
 #include "PhysicsWorld.h"
 #include "ProfileManager.h"
 #include "QuadRenderer.h"
+#include "RenderQueue.h"
 #include "ShaderPath.h"
 #include "ObjectShader.h"
 #include "BackgroundShader.h"
 #include "StateFactory.h"
+#include "StreamBuffer.h"
 #include "TextRenderer.h"
 #include "TextureManager.h"
+#include "ThumbnailAtlas.h"
 #include "Timer.h"
 
 using namespace std;
@@ -99,6 +104,7 @@ bool GameEngine::init(const char* title, int width, int height) {
 
     // Physics/space related
     physicsWorld = new PhysicsWorld();
+    physicsWorld->enableProfiling();
     initCamera();
     initShaders();
     initRenderers();
@@ -220,6 +226,10 @@ void GameEngine::update() {
 }
 
 void GameEngine::draw() {
+    // Finish a slice of any background texture loads before they are drawn
+    tm.update();
+    thumbnails->beginFrame();
+
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); // Clear both color and depth buffers
 
     // START IMGUI FRAME: applies to all states
@@ -242,6 +252,7 @@ void GameEngine::draw() {
     // END IMGUI FRAME: renders to screen
     ImGui::Render();
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+    StreamBuffer::getInstance().endFrame();
     glfwSwapBuffers(window);
 }
 
@@ -277,6 +288,12 @@ void GameEngine::cleanup() {
     }
 
     delete quadRenderer;
+    delete renderQueue;
+    delete debugRenderer;
+    delete thumbnails;
+    MeshManager::getInstance().clear();
+    tm.clear();
+    StreamBuffer::getInstance().cleanup();
     delete objectShader;
     delete backgroundShader;
     delete textRenderer;
@@ -351,6 +368,34 @@ void GameEngine::drawDebugScreen()
     ImGui::Text("Mouse Position: (%.1f, %.1f)", mouseX, mouseY);
     ImGui::Text(coordsText.c_str());
     ImGui::Text("OpenGL Version: %s", glGetString(GL_VERSION));
+    ImGui::Text("Beyblade meshes loaded: %d, %d template combinations", int(MeshManager::getInstance().getLiveCount()),
+        int(MeshManager::getInstance().getTemplateCount()));
+    ImGui::Text("Textures loading: %d", int(tm.getPendingCount()));
+
+    const RenderStats& renderStats = renderQueue->getLastStats();
+    ImGui::Text("Draws: %d submitted, %d culled, %d calls", renderStats.submitted, renderStats.culled, renderStats.drawCalls);
+    ImGui::Text("State changes: %d shader, %d texture, %d VAO", renderStats.shaderChanges, renderStats.textureChanges, renderStats.vaoChanges);
+    ImGui::Text("Debug lines: %d", int(debugRenderer->getLastLineCount()));
+    ImGui::Text("Thumbnails: %d cached, %d rendered", int(thumbnails->getCachedCount()), thumbnails->getLastRenderCount());
+
+    const StreamBuffer& streamBuffer = StreamBuffer::getInstance();
+    const StreamStats& streamStats = streamBuffer.getLastStats();
+    ImGui::Text("Streamed: %.1f KB in %d pushes (%s)", streamStats.bytes / 1024.0f, streamStats.allocations,
+        streamBuffer.isPersistent() ? "persistent" : "subdata");
+    ImGui::Text("Stream waits: %d stalls, %.2f ms, %d orphans", streamStats.stalls, streamStats.stallMs, streamStats.orphans);
+
+    // Physics timings over the last PhysicsProfiler::HISTORY_SIZE ticks
+    if (const PhysicsProfiler* profiler = physicsWorld->getProfiler()) {
+        ImGui::Text("Physics (%d ticks): avg / p99 / max", int(profiler->getTickCount()));
+        for (int phase = 0; phase < int(PhysicsPhase::COUNT); ++phase) {
+            PhysicsStat stat = profiler->getStat(PhysicsPhase(phase));
+            ImGui::Text("  %-16s %.3f / %.3f / %.3f ms", PhysicsProfiler::getName(PhysicsPhase(phase)), stat.average, stat.p99, stat.max);
+        }
+        for (int counter = 0; counter < int(PhysicsCounter::COUNT); ++counter) {
+            PhysicsStat stat = profiler->getStat(PhysicsCounter(counter));
+            ImGui::Text("  %-16s %.2f / %.0f / %.0f per tick", PhysicsProfiler::getName(PhysicsCounter(counter)), stat.average, stat.p99, stat.max);
+        }
+    }
 
     ImGui::Text("Profiles:");
     auto activeProfile = pm.getActiveProfile();
@@ -396,7 +441,10 @@ void GameEngine::drawDebugScreen()
         stadiumOss.precision(2);
         stadiumOss << std::fixed
             << "Radius: " << activeStadium->getRadius().value() << " m, "
-            << "Vertices Per Ring: " << activeStadium->getVerticesPerRing();
+            << "Vertices Per Ring: " << activeStadium->getVerticesPerRing() << ", "
+            << "BVH: " << activeStadium->getBVH().getNodeCount() << " nodes, "
+            << activeStadium->getBVH().getMemoryUsage() / 1024.0 << " KB, "
+            << "LOD: " << activeStadium->getLodLevel() << " (" << activeStadium->getLodTriangleCount() << " triangles)";
         ImGui::Text(stadiumOss.str().c_str());
     }
     else {
@@ -539,6 +587,9 @@ void GameEngine::initShaders()
 
 void GameEngine::initRenderers() {
     quadRenderer = new QuadRenderer();
+    renderQueue = new RenderQueue();
+    debugRenderer = new DebugRenderer();
+    thumbnails = new ThumbnailAtlas();
 
     textRenderer = new TextRenderer("./assets/fonts/OpenSans-Regular.ttf", 800, 600);
     tm.loadTexture("defaultBackground", "./assets/textures/Brickbeyz.jpg");
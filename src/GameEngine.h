@@ -29,6 +29,9 @@ class ProfileManager;
 class TextureManager;
 class QuadRenderer;
 class TextRenderer;
+class RenderQueue;
+class DebugRenderer;
+class ThumbnailAtlas;
 
 class GameEngine {
 public:
@@ -95,6 +98,9 @@ public:
 
     TextRenderer* textRenderer{};
     QuadRenderer* quadRenderer{};
+    RenderQueue* renderQueue{};     // 3D scene draws, see ActiveState::draw
+    DebugRenderer* debugRenderer{}; // Lines for debugMode, flushed after the scene
+    ThumbnailAtlas* thumbnails{};   // Beyblade and stadium list images, see Thumbnails.h
 
     float currTime{};
     float prevTime{};
@@ -8,8 +8,10 @@
 #include "Beyblade.h"
 #include "BeybladeParts.h"
 #include "Buffers.h"
+#include "InstanceBatch.h"
 #include "MeshObject.h"
 #include "MeshObjects/BeybladeMesh.h"
+#include "MeshManager.h"
 #include "RigidBody.h"
 #include "RigidBodies/BeybladeBody.h"
 #include "ObjectShader.h"
@@ -37,13 +39,11 @@ Beyblade::Beyblade(int id, const string& name, bool isTemplate) :
     if (isTemplate) {
         setTemplateIndices(0, 0, 0);
         body = make_unique<BeybladeBody>(templateLayers[0].part, templateDiscs[0].part, templateDrivers[0].part);
-        // TODO: Implement a combineMesh function. Requires all obj files to be standardized, centered and aligned correctly. Then combine them
-        mesh = make_unique<BeybladeMesh>();
-        //mesh = combineMesh(templateLayers[0].modelPath, templateDiscs[0].modelPath, templateDrivers[0].modelPath);
+        mesh = MeshManager::getInstance().getTemplateMesh(0, 0, 0);    // Part models stacked into one mesh
     }
     else {
         body = make_unique<BeybladeBody>();
-        mesh = make_unique<BeybladeMesh>();
+        mesh = MeshManager::getInstance().getMesh(DEFAULT_MODEL_PATH);
     }
 }
 
@@ -56,10 +56,13 @@ string Beyblade::getName() const {
 BeybladeBody* Beyblade::getBody() {
     return body.get();
 }
+const BeybladeBody* Beyblade::getBody() const {
+    return body.get();
+}
 BeybladeMesh* Beyblade::getMesh() {
     return mesh.get();
 }
-void Beyblade::setMesh(std::unique_ptr<BeybladeMesh> &newMesh) {
+void Beyblade::setMesh(std::shared_ptr<BeybladeMesh> newMesh) {
     mesh = std::move(newMesh);
 }
 void Beyblade::setName(const std::string& newName) { 
@@ -68,23 +71,41 @@ void Beyblade::setName(const std::string& newName) {
 
 
 void Beyblade::render(ObjectShader& shader)
+{
+    render(shader, body->getCenter().value());
+}
+
+/**
+* Render at a given position, e.g. from a PhysicsSnapshot while the body is owned by the physics thread.
+*/
+
+void Beyblade::render(ObjectShader& shader, const glm::vec3& center)
 {
     shader.use();
 
-    glm::mat4 model = glm::translate(glm::mat4(1.0f), body->getCenter().value());
+    glm::mat4 model = glm::translate(glm::mat4(1.0f), center);
 
     shader.setObjectRenderParams(model, glm::vec3(1.0f));
 
     mesh->render(shader);
 }
 
+/**
+* Queue for instanced drawing. Nothing is drawn until the batch is flushed.
+*/
+
+void Beyblade::render(InstanceBatch& batch, const glm::vec3& center)
+{
+    batch.add(mesh.get(), glm::translate(glm::mat4(1.0f), center), mesh->tint);
+}
+
 void Beyblade::update(int layerIndex, int discIndex, int driverIndex) {
     setTemplateIndices(layerIndex, discIndex, driverIndex);
     TemplateFormat<Layer> layer = templateLayers[layerIndex];
     TemplateFormat<Disc> disc = templateDiscs[discIndex];
     TemplateFormat<Driver> driver = templateDrivers[driverIndex];
     body = make_unique<BeybladeBody>(layer.part, disc.part, driver.part);
-    //mesh = make_unique<BeybladeMesh>(combineMesh(templateLayers[0].modelPath, templateDiscs[0].modelPath, templateDrivers[0].modelPath));
+    mesh = MeshManager::getInstance().getTemplateMesh(layerIndex, discIndex, driverIndex);
 }
 
 
@@ -94,6 +115,9 @@ json Beyblade::toJson() const {
     j["id"] = id;
     j["name"] = name;
     j["isTemplate"] = isTemplate;
+    if (isTemplate) {
+        j["templateIndices"] = { templateIndices[0], templateIndices[1], templateIndices[2] };
+    }
 
     // Serialize BeybladeBody
     if (body) {
@@ -199,9 +223,16 @@ Beyblade Beyblade::fromJson(const nlohmann::json& j) {
     }
 
     // Deserialize mesh (init() upon instantiation shoul handle most)
-    if (j.contains("mesh")) {
+    // Templates rebuild theirs from the parts; the combined mesh's path is only a cache file
+    if (isTemplate && j.contains("templateIndices")) {
+        const auto& indices = j.at("templateIndices");
+        beyblade.setTemplateIndices(indices.at(0).get<int>(), indices.at(1).get<int>(), indices.at(2).get<int>());
+        beyblade.mesh = MeshManager::getInstance().getTemplateMesh(beyblade.templateIndices[0], beyblade.templateIndices[1],
+            beyblade.templateIndices[2]);
+    }
+    else if (j.contains("mesh") && !isTemplate) {
         std::string modelPath = j.at("mesh").at("modelPath").get<std::string>();
-        beyblade.mesh = std::make_unique<BeybladeMesh>(modelPath, 0, 0, 0, glm::vec3(1.0f)); // TOLOOK: Inspect what is really needed do be stored in this call. Not tested.
+        beyblade.mesh = MeshManager::getInstance().getMesh(modelPath);
     }
 
     return beyblade;
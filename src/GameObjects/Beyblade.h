@@ -17,6 +17,7 @@
 #include "BeybladeTemplate.h"
 
 class ObjectShader;
+class InstanceBatch;
 
 class Beyblade {
     friend class BeybladeMesh;
@@ -28,14 +29,17 @@ public:
     static Beyblade fromJson(const nlohmann::json& j);
 
     void render(ObjectShader& shader);
+    void render(ObjectShader& shader, const glm::vec3& center);
+    void render(InstanceBatch& batch, const glm::vec3& center);
 
     int getId() const;
     std::string getName() const;
     void setName(const std::string &newName);
 
     BeybladeBody *getBody();
+    const BeybladeBody *getBody() const;
     BeybladeMesh *getMesh();
-    void setMesh(std::unique_ptr<BeybladeMesh> &newMesh);
+    void setMesh(std::shared_ptr<BeybladeMesh> newMesh);
 
     void update(int layerIndex, int discIndex, int driverIndex);
 
@@ -51,7 +55,7 @@ private:
     const int id; // Globally unique, will be managed by centralized server
     std::string name;
     std::unique_ptr<BeybladeBody> body;
-    std::unique_ptr<BeybladeMesh> mesh;
+    std::shared_ptr<BeybladeMesh> mesh;     // Shared with every beyblade using the same model, see MeshManager
 
     void setTemplateIndices(int layerIndex, int discIndex, int driverIndex);
 };
\ No newline at end of file
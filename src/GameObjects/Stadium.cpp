@@ -3,10 +3,15 @@
 // Copyright (c) 2024, Ricky Zhang.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+
 #include <glm/gtc/matrix_transform.hpp>
 #include "Buffers.h"
 #include "Stadium.h"
 #include "ObjectShader.h"
+#include "RenderQueue.h"
+#include "TextureManager.h"
+#include "Utils.h"
 
 using namespace std;
 using namespace glm;
@@ -27,12 +32,8 @@ Stadium::Stadium(
     shared_ptr<Texture> texture,
     float textureScale
 )
-    : id(id), name(name),
-    center(Vec3_M(center)),
-    radius(M(radius)),
-    curvature(Scalar(curvature)),
-    scaledCurvature(__M(curvature / radius)),
-    coefficientOfFriction(Scalar(coefficientOfFriction)),
+    : StadiumBody(center, radius, curvature, coefficientOfFriction),
+    id(id), name(name),
     verticesPerRing(verticesPerRing),
     numRings(numRings),
     ringColor(ringColor),
@@ -96,7 +97,7 @@ Stadium Stadium::fromJson(const json& j) {
 
         if (j.contains("texture")) {
             string texturePath = j["texture"];
-            stadium.setTexture(make_shared<Texture>(texturePath.c_str()));
+            stadium.setTexture(TextureManager::getInstance().loadTexture(texturePath, texturePath));
         }
 
         return stadium;
@@ -109,263 +110,230 @@ Stadium Stadium::fromJson(const json& j) {
 * Stadium renderer
 */
 
-void Stadium::render(ObjectShader& shader) {
+void Stadium::render(ObjectShader& shader, const vec3& viewPos, float pixelScale) {
+    updateMesh();   // Only does anything after the ring or vertex counts change
+    lodLevel = selectLodLevel(viewPos, pixelScale);
     setModelMatrix(translate(mat4(1.0f), center.value())); // TODO: This only needs to be called when the center is set/changed
 
+    shader.setObjectRenderParams(modelMatrix, tint);
+
     // Assume that stadium textures are tied to the object itself
-    MeshObject::render(shader, texture.get());
+    if (texture) texture->use();
+
+    glBindVertexArray(VAO);
+    drawSurface(shader);
+    glBindVertexArray(0);
+    GL_CHECK("Stadium");
 }
 
 /**
-* Checks whether a point is in the x-z plane of the stadium.
+* Queue the stadium for drawing. Same as render(), but the queue culls it and binds the shared state.
+*
+* @param queue                  [in/out] Frame's render queue.
+* @param shader                 [in] Object shader.
+* @param viewPos                [in] Camera position.
+* @param pixelScale             [in] See getProjectionPixelScale().
 */
-bool Stadium::isInside(M x, M z) const {
-    M scaledX = x - center.xTyped();
-    M scaledZ = z - center.zTyped();
-    return scaledX * scaledX + scaledZ * scaledZ < radius * radius;
-}
 
-// Returns the y-coordinate of the stadium at a given r in LOCAL space, where the stadium bottom (vertex) is at 0.0
-const M Stadium::getYLocal(M r) const
-{
-    return scaledCurvature * r * r;
-}
+void Stadium::submit(RenderQueue& queue, ObjectShader& shader, const vec3& viewPos, float pixelScale) {
+    updateMesh();
+    lodLevel = selectLodLevel(viewPos, pixelScale);
+    setModelMatrix(translate(mat4(1.0f), center.value()));
 
-/**
-* Returns the y-coordinate of the stadium at a given x and z.
-*/
-const M Stadium::getY(M x, M z) const {
-    M scaledX = x - center.xTyped();
-    M scaledZ = z - center.zTyped();
-    M scaledY = scaledCurvature * (scaledX * scaledX + scaledZ * scaledZ);
-    return scaledY + center.yTyped();
+    DrawPacket packet;
+    packet.shader = &shader;
+    packet.texture = texture.get();
+    packet.vao = VAO;
+    packet.model = modelMatrix;
+    packet.tint = tint;
+
+    float radius = this->radius.value();
+    float rimHeight = getYLocal(this->radius).value();
+    vec3 localMin(-radius, std::min(0.0f, rimHeight), -radius);
+    vec3 localMax(radius, std::max(0.0f, rimHeight), radius);
+    RenderQueue::transformBounds(modelMatrix, localMin, localMax, packet.boundsMin, packet.boundsMax);
+
+    packet.draw = [this](ObjectShader& boundShader, const DrawPacket& queued) {
+        boundShader.setObjectRenderParams(queued.model, queued.tint);
+        drawSurface(boundShader);
+    };
+    queue.submit(packet);
 }
 
 /**
-* Returns the unit normal of the stadium at a given x and z.
+* Draw the current level of detail with the stadium's VAO bound. The vertex shader builds the surface from these
+* uniforms, so shape and color edits need no mesh rebuild.
 */
-const Vec3_Scalar Stadium::getNormal(M x, M z) const {
-    M scaledX = x - center.xTyped();
-    M scaledZ = z - center.zTyped();
-    Vec3_Scalar normal = normalize(Vec3_Scalar(
-        (-2.0__ * scaledCurvature * scaledX).value(),
-        1.0f,
-        (-2.0__ * scaledCurvature * scaledZ).value()));
-    return normal;
-}
 
+void Stadium::drawSurface(ObjectShader& shader) const {
+    shader.setStadiumSurface(true);
+    shader.setStadiumParams(radius.value(), scaledCurvature.value(), verticesPerRing, numRings, textureScale,
+        ringColor, crossColor, tint);
 
+    const LodLevel& level = lodLevels[lodLevel];
+    glDrawElements(GL_TRIANGLES, GLsizei(level.indexCount), GL_UNSIGNED_INT, (void*)(level.firstIndex * sizeof(unsigned int)));
 
-void Stadium::updateMesh() {
-    if (!meshChanged) return;
-    meshChanged = false;
+    shader.setStadiumSurface(false);
+}
 
-    vector<float> vertexData;
+/**
+* Find where a world space ray first hits the stadium mesh.
+*
+* @param origin                 [in] Ray origin.
+* @param direction              [in] Ray direction. Need not be unit length.
+* @param maxDistance            [in] Ignore hits further than this, in units of direction's length.
+* @param hit                    [out] Nearest hit, in world space. Only set if there is one.
+*
+* @return true if the ray hits within maxDistance.
+*/
 
-    // Clear existing data
-    vertices.clear();
-    normals.clear();
-    texCoords.clear();
-    indices.clear();
-    //tangents.clear();
+bool Stadium::raycast(const vec3& origin, const vec3& direction, float maxDistance, TriangleBVH::Hit& hit) const {
+    vec3 offset = center.value();
+    if (!getBVH().raycast(origin - offset, direction, maxDistance, hit)) return false;
+    hit.point += offset;
+    return true;
+}
 
-    // Add center vertex first
-    vertices.emplace_back(0, 0, 0);
-    texCoords.emplace_back(0.5, 0.5);
-    colors.emplace_back(crossColor);
+/**
+* BVH over the same triangles the vertex shader draws, in local coordinates. Rebuilt on first use after the shape
+* changes, so only code that ray casts pays for it.
+*/
 
-    if (verticesPerRing % 4 != 0) {
-        cerr << "Vertices per ring must be a multiple of 4" << endl;
-        //return;
+const TriangleBVH& Stadium::getBVH() const {
+    if (bvhChanged) {
+        vector<vec3> positions;
+        generatePositions(positions);
+        bvh.build(positions, indices);
+        bvhChanged = false;
     }
+    return bvh;
+}
 
-    float radius = this->radius.value();
+/**
+* CPU copy of the surface the vertex shader generates: the center, then verticesPerRing vertices for each ring from
+* the inside out. Only used for ray queries.
+*/
+
+void Stadium::generatePositions(vector<vec3>& positions) const {
+    positions.clear();
+    positions.reserve(size_t(numRings) * verticesPerRing + 1);
+    positions.emplace_back(0, 0, 0);
 
-    // Generate vertices
+    float radius = this->radius.value();
     for (int rIdx = 1; rIdx <= numRings; ++rIdx) {
         float r = powf(static_cast<float>(rIdx) / numRings, 0.5f) * static_cast<float>(radius);
         for (int thetaIdx = 0; thetaIdx < verticesPerRing; ++thetaIdx) {
             float theta = (float)(2.0f * M_PI * static_cast<float>(thetaIdx) / static_cast<float>(verticesPerRing));
-            float x = r * cos(theta);
-            float z = r * sin(theta);
-            float y = getYLocal(M(r)).value();
-
-            vertices.emplace_back(x, y, z);
-            texCoords.emplace_back(textureScale * (r / radius * cos(theta)) + 0.5f,
-                textureScale * (r / radius * sin(theta)) + 0.5f);
-
-            // Set ring color for middle and end
-            if (rIdx == numRings / 4 || rIdx == numRings - 1) {
-                colors.emplace_back(ringColor);
-            }
-            else if (thetaIdx == 0 || thetaIdx == verticesPerRing / 4 || thetaIdx == verticesPerRing / 2 || thetaIdx == 3 * verticesPerRing / 4) {
-                colors.emplace_back(crossColor);
-            }
-            else {
-                colors.emplace_back(tint);
-            }
-            //            // Create a spiral color pattern
-            //            if ((rIdx + thetaIdx * 2) % (verticesPerRing / 2) < verticesPerRing / (numRings / 2)) {
-            //                colors.emplace_back(ringColor);
-            //            } else if (thetaIdx % (verticesPerRing / 12) == 0) {
-            //                colors.emplace_back(crossColor);
-            //            } else {
-            //                colors.emplace_back(color);
-            //            }
+            positions.emplace_back(r * cos(theta), getYLocal(M(r)).value(), r * sin(theta));
         }
     }
+}
+
+/**
+* Append the triangles of the polar grid using every step-th ring and spoke, with the same winding as full detail.
+* The rings and spokes that carry the ring and cross colors are always kept.
+*
+* @param out                    [in/out] Index list to append to.
+* @param step                   [in] Ring and spoke step. verticesPerRing / 4 must be a multiple of it.
+*/
 
-    normals.resize(vertices.size(), vec3(0.0f));
-    //tangents.resize(vertices.size(), vec3(0.0f));
+void Stadium::appendGridIndices(vector<unsigned int>& out, int step) const {
+    vector<int> rings;
+    for (int rIdx = 1; rIdx <= numRings; ++rIdx) {
+        if (rIdx % step == 0 || rIdx == numRings / 4 || rIdx == numRings - 1 || rIdx == numRings) rings.push_back(rIdx);
+    }
+    auto vertexId = [this](int rIdx, int spoke) {
+        return unsigned(1 + (rIdx - 1) * verticesPerRing + spoke % verticesPerRing);
+    };
 
     // Draw from origin to first ring
-    for (int i = 0; i < verticesPerRing; ++i) {
-        int origin = 0;
-        int curr = i + 1;
-        int next = (i + 1) % verticesPerRing + 1;
-        indices.push_back(origin);
-        indices.push_back(curr);
-        indices.push_back(next);
-        vec3 v0 = vertices[origin];
-        vec3 v1 = vertices[curr];
-        vec3 v2 = vertices[next];
-        vec3 edge1 = v1 - v0;
-        vec3 edge2 = v2 - v0;
-        vec3 normal = normalize(cross(edge1, edge2));
-        normals[origin] += normal;
-        normals[curr] += normal;
-        normals[next] += normal;
-        // Calculate tangent for the triangle
-        vec2 uv0 = texCoords[origin];
-        vec2 uv1 = texCoords[curr];
-        vec2 uv2 = texCoords[next];
-        vec2 deltaUV1 = uv1 - uv0;
-        vec2 deltaUV2 = uv2 - uv0;
-        float f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
-        vec3 tangent = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
-        //tangents[origin] += tangent;
-        //tangents[curr] += tangent;
-        //tangents[next] += tangent;
+    for (int i = 0; i < verticesPerRing; i += step) {
+        out.push_back(0);
+        out.push_back(vertexId(rings[0], i));
+        out.push_back(vertexId(rings[0], i + step));
     }
 
-    // Do pairs starting from (1, 2) to (n-1, n)
-    for (int rIdx = 1; rIdx < numRings; ++rIdx) {
-        int offset1 = (rIdx - 1) * verticesPerRing + 1;
-        int offset2 = rIdx * verticesPerRing + 1;
-
-        for (int vertIdx = 0; vertIdx < verticesPerRing; ++vertIdx) {
-            int curr1 = offset1 + vertIdx;
-            int next1 = offset1 + (vertIdx + 1) % verticesPerRing;
-            int curr2 = offset2 + vertIdx;
-            int next2 = offset2 + (vertIdx + 1) % verticesPerRing;
+    // Then between each pair of kept rings
+    for (size_t j = 1; j < rings.size(); ++j) {
+        for (int vertIdx = 0; vertIdx < verticesPerRing; vertIdx += step) {
+            unsigned int curr1 = vertexId(rings[j - 1], vertIdx);
+            unsigned int next1 = vertexId(rings[j - 1], vertIdx + step);
+            unsigned int curr2 = vertexId(rings[j], vertIdx);
+            unsigned int next2 = vertexId(rings[j], vertIdx + step);
 
             // Triangle 1: (curr1, curr2, next1)
-            indices.push_back(curr1);
-            indices.push_back(curr2);
-            indices.push_back(next1);
-
-            // Calculate normal for Triangle 1
-            vec3 v0 = vertices[curr1];
-            vec3 v1 = vertices[curr2];
-            vec3 v2 = vertices[next1];
-            vec3 edge1 = v1 - v0;
-            vec3 edge2 = v2 - v0;
-            vec3 normal = normalize(cross(edge1, edge2));
-
-            normals[curr1] += normal;
-            normals[curr2] += normal;
-            normals[next1] += normal;
-
-            // Calculate tangent for Triangle 1
-            vec2 uv0 = texCoords[curr1];
-            vec2 uv1 = texCoords[curr2];
-            vec2 uv2 = texCoords[next1];
-            vec2 deltaUV1 = uv1 - uv0;
-            vec2 deltaUV2 = uv2 - uv0;
-            //float f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
-            //vec3 tangent = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
-            //tangents[curr1] += tangent;
-            //tangents[curr2] += tangent;
-            //tangents[next1] += tangent;
+            out.push_back(curr1);
+            out.push_back(curr2);
+            out.push_back(next1);
 
             // Triangle 2: (next1, curr2, next2)
-            indices.push_back(next1);
-            indices.push_back(curr2);
-            indices.push_back(next2);
-
-            // Calculate normal for Triangle 2
-            v0 = vertices[next1];
-            v1 = vertices[curr2];
-            v2 = vertices[next2];
-            edge1 = v1 - v0;
-            edge2 = v2 - v0;
-            normal = normalize(cross(edge1, edge2));
-
-            normals[next1] += normal;
-            normals[curr2] += normal;
-            normals[next2] += normal;
-
-            // Calculate tangent for Triangle 2
-            uv0 = texCoords[next1];
-            uv1 = texCoords[curr2];
-            uv2 = texCoords[next2];
-            deltaUV1 = uv1 - uv0;
-            deltaUV2 = uv2 - uv0;
-            //f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
-            //tangent = f * (deltaUV2.y * edge1 - deltaUV1.y * edge2);
-            //tangents[next1] += tangent;
-            //tangents[curr2] += tangent;
-            //tangents[next2] += tangent;
+            out.push_back(next1);
+            out.push_back(curr2);
+            out.push_back(next2);
         }
     }
+}
 
-    for (auto& normal : normals) {
-        normal = normalize(normal);
-    }
-    //for (auto& tangent : tangents) {
-    //    tangent = normalize(tangent);
-    //}
+/**
+* Rebuild the polar grid's index buffers. Only the ring and vertex counts affect them; everything else is a uniform
+* (see render()). There is no vertex buffer: the vertex shader works from gl_VertexID.
+*
+* Level 0 is full detail. Each further level halves the rings and spokes, down to 16 spokes, and all levels share
+* one EBO.
+*/
 
-    // Calculate bounding boxes for each triangle
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        vec3 v1 = vertices[indices[i]];
-        vec3 v2 = vertices[indices[i + 1]];
-        vec3 v3 = vertices[indices[i + 2]];
+void Stadium::updateMesh() {
+    if (!meshChanged && VAO != 0) return;   // Copies start without GL objects, see MeshObject
+    meshChanged = false;
+    bvhChanged = true;
 
-        auto bbox = new BoundingBox();
-        bbox->update(v1, v2, v3);
+    if (verticesPerRing % 4 != 0) {
+        cerr << "Vertices per ring must be a multiple of 4" << endl;
+        //return;
+    }
 
-        // Add the bounding box to the immovable rigid body
-        boundingBoxes.push_back(bbox);
+    indices.clear();
+    appendGridIndices(indices, 1);
+
+    vector<unsigned int> allLevels = indices;
+    lodLevels.assign(1, { 0, indices.size(), verticesPerRing });
+    for (int step = 2; (verticesPerRing / 4) % step == 0 && verticesPerRing / step >= 16; step *= 2) {
+        size_t first = allLevels.size();
+        appendGridIndices(allLevels, step);
+        lodLevels.push_back({ first, allLevels.size() - first, verticesPerRing / step });
     }
+    lodLevel = 0;
 
-    /*******************************************************************/
+    if (VAO == 0) glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+    updateBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO, allLevels.data(), allLevels.size() * sizeof(unsigned int));
+    glBindVertexArray(0);
+}
 
-    if (vertices.size() != normals.size() || vertices.size() != texCoords.size()) {
-        cerr << "Mesh data is inconsistent" << endl;
-        cout << "Vertices: " << vertices.size() << ", Normals: " << normals.size() << ", TexCoords: " << texCoords.size() << endl;
-        return;
-    }
-    for (size_t i = 0; i < vertices.size(); ++i) {
-        // Vertex positions
-        vertexData.push_back(vertices[i].x);
-        vertexData.push_back(vertices[i].y);
-        vertexData.push_back(vertices[i].z);
-
-        // Normal data
-        vertexData.push_back(normals[i].x);
-        vertexData.push_back(normals[i].y);
-        vertexData.push_back(normals[i].z);
-
-        // Texture coordinates
-        vertexData.push_back(texCoords[i].x);
-        vertexData.push_back(texCoords[i].y);
-
-        // Color data
-        vertexData.push_back(colors[i].x);
-        vertexData.push_back(colors[i].y);
-        vertexData.push_back(colors[i].z);
+/**
+* Pick the coarsest level whose edges are still about LOD_EDGE_PIXELS long on screen. Moving to a coarser level
+* needs some margin so a camera sitting at a threshold does not flicker between two levels.
+*
+* @param viewPos                [in] Camera position.
+* @param pixelScale             [in] Pixels covered by 1 m at 1 m distance, 0 for full detail.
+*/
+
+int Stadium::selectLodLevel(const vec3& viewPos, float pixelScale) const {
+    constexpr float LOD_EDGE_PIXELS = 4.0f;
+    constexpr float LOD_HYSTERESIS = 1.25f;
+
+    float radius = this->radius.value();
+    float distance = length(viewPos - center.value());
+    if (pixelScale <= 0.0f || distance <= radius) return 0;
+
+    // Rim circumference in pixels over the edge length gives the spokes needed
+    float spokesNeeded = 2.0f * float(M_PI) * radius * pixelScale / distance / LOD_EDGE_PIXELS;
+
+    int level = 0;
+    while (level + 1 < int(lodLevels.size())) {
+        float margin = level + 1 > lodLevel ? LOD_HYSTERESIS : 1.0f;
+        if (lodLevels[level + 1].spokes < spokesNeeded * margin) break;
+        ++level;
     }
-    setupBuffers(VAO, VBO, EBO, vertexData.data(), vertexData.size() * sizeof(float), indices.data(),
-        indices.size() * sizeof(unsigned int), { 3, 3, 2, 3 });
-}
\ No newline at end of file
+    return level;
+}
@@ -6,7 +6,8 @@
 #pragma once
 
 /**
- * Because the mathematical parameters / rendering process of stadiums are intertwined, this class combines mesh and body
+ * Because the mathematical parameters / rendering process of stadiums are intertwined, this class combines mesh and body.
+ * The physical half lives in StadiumBody so simulations can copy it without any GL state.
  *
  * center is where the stadium is located in the world, so local coordinates must be shifted correspondingly
  *
@@ -28,14 +29,16 @@
 
 #include "DefaultValues.h"
 #include "MeshObject.h"
+#include "StadiumBody.h"
 #include "BoundingBox.h"
+#include "TriangleBVH.h"
 #include "Units.h"
 #include "Texture.h"
 #include "ShaderPath.h"
 
 using namespace Units;
 
-class Stadium : public MeshObject {
+class Stadium : public MeshObject, public StadiumBody {
 public:
     Stadium(
         int id = -1,
@@ -67,7 +70,8 @@ public:
             this->crossColor = other.crossColor;
             this->textureScale = other.textureScale;
             this->texture = other.texture;  // Copy with shared ownership
-            this->meshChanged = other.meshChanged;
+            this->meshChanged = true;       // Ring and vertex counts may differ from this stadium's index buffer
+            this->bvhChanged = true;
         }
         return *this;
     }
@@ -77,20 +81,19 @@ public:
 
     virtual void updateMesh() override;
 
-    void render(ObjectShader& shader);
+    // viewPos and pixelScale (see getProjectionPixelScale()) pick the level of detail; a pixelScale of 0 draws full detail
+    void render(ObjectShader& shader, const glm::vec3& viewPos = glm::vec3(0.0f), float pixelScale = 0.0f);
+    void submit(RenderQueue& queue, ObjectShader& shader, const glm::vec3& viewPos, float pixelScale);
+    int getLodLevel() const { return lodLevel; }
+    size_t getLodTriangleCount() const { return lodLevels.empty() ? 0 : lodLevels[lodLevel].indexCount / 3; }
 
-    bool isInside(M x, M z) const;
-    const M getYLocal(M r) const;
-    const M getY(M x, M z) const;
-    const Vec3_Scalar getNormal(M x, M z) const;
+    // Ray picking and camera collision against the rendered surface
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, TriangleBVH::Hit& hit) const;
+    const TriangleBVH& getBVH() const;
 
-    // Getters (read-only access)
+    // Getters (read-only access). Physical getters are in StadiumBody
     int getId() const { return id; }
     std::string getName() const { return name; }
-    Vec3_M getCenter() const { return center; }
-    const M getRadius() const { return radius; }
-    const Scalar getCurvature() const { return curvature; }
-    Scalar getCOF() const { return coefficientOfFriction; }
     int getVerticesPerRing() const { return verticesPerRing; }
     int getNumRings() const { return numRings; }
     glm::vec3 getRingColor() const { return ringColor; }
@@ -106,22 +109,22 @@ public:
     void setRadius(float newRadius) {
         radius = M(newRadius);
         scaledCurvature = __M(curvature.value() / newRadius);
-        meshChanged = true;
+        bvhChanged = true;
     }
     void setCurvature(float newCurvature) {
         curvature = Scalar(newCurvature);
         scaledCurvature = __M(newCurvature / radius.value());
-        meshChanged = true;
+        bvhChanged = true;
     }
     void setFriction(float newFriction) {
         coefficientOfFriction = Scalar(newFriction);
     }
     void setCenter(const glm::vec3& newCenter) {
-        center = Vec3_M(newCenter);
-        meshChanged = true;
+        center = Vec3_M(newCenter);     // The mesh is local, so only the model matrix changes
     }
     void setVerticesPerRing(int newVerticesPerRing) {
         verticesPerRing = newVerticesPerRing;
+        meshChanged = true;
     }
     void setNumRings(int newNumRings) {
         numRings = newNumRings;
@@ -129,19 +132,15 @@ public:
     }
     void setRingColor(const glm::vec3& newRingColor) {
         ringColor = newRingColor;
-        meshChanged = true;
     }
     void setCrossColor(const glm::vec3& newCrossColor) {
         crossColor = newCrossColor;
-        meshChanged = true;
     }
     void setTextureScale(float newTextureScale) {
         textureScale = newTextureScale;
-        meshChanged = true;
     }
     void setTexture(std::shared_ptr<Texture> newTexture) {
-        texture = std::move(newTexture);
-        meshChanged = true;
+        texture = std::move(newTexture);    // Bound at render time
     }
 
     bool getModified() const {
@@ -151,20 +150,11 @@ public:
         modified = _modified;
     }
 
-    std::vector<BoundingBox*> boundingBoxes;
 private:
     // General
     std::string name;
     int id;       // -1 is a temporary id. Otherwise, all other ids are 
 
-    // Physical values
-    Vec3_M center;
-    M radius;
-    Scalar curvature;
-    __M scaledCurvature;
-    Scalar coefficientOfFriction;
-
-    // TOFIX: ringColor and crossColor don't affect at all?
     // Rendering
     int verticesPerRing;
     int numRings;
@@ -172,7 +162,23 @@ private:
     glm::vec3 crossColor;
     float textureScale;
     std::shared_ptr<Texture> texture;
+    mutable TriangleBVH bvh;    // Local coordinates, GL free. Built by getBVH()
+    mutable bool bvhChanged = true;
 
-    bool meshChanged = true;    // Whether the mesh has changed. Used for rendering purposes
+    bool meshChanged = true;    // Whether the ring or vertex counts changed, i.e. the index buffer
     bool modified = false;      // Whether any parameter has changed. Used for customization update purposes.
+
+    // Coarser grids drawn from the same vertices, so switching levels never cracks the surface
+    struct LodLevel {
+        size_t firstIndex;      // Into the EBO
+        size_t indexCount;
+        int spokes;             // Vertices per ring at this level
+    };
+    std::vector<LodLevel> lodLevels;    // 0 is full detail
+    int lodLevel = 0;
+
+    void generatePositions(std::vector<glm::vec3>& positions) const;
+    void drawSurface(ObjectShader& shader) const;
+    void appendGridIndices(std::vector<unsigned int>& out, int step) const;
+    int selectLodLevel(const glm::vec3& viewPos, float pixelScale) const;
 };
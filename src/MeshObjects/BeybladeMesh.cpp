@@ -1,18 +1,60 @@
 #include "BeybladeMesh.h"
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <iomanip>
+#include <numeric>
 
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
 
 #include "Buffers.h"
+#include "InstanceBatch.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
 #include "MessageLog.h"
+#include "ObjParser.h"
 #include "ObjectShader.h"
+#include "StreamBuffer.h"
 
 using namespace std;
 using namespace glm;
 
+BeybladeMesh::~BeybladeMesh() {
+    if (VAO == 0 && VBO == 0 && EBO == 0) return;   // Never uploaded, e.g. by importModel() off the GL thread
+    glDeleteVertexArrays(1, &VAO);
+    glDeleteBuffers(1, &VBO);
+    glDeleteBuffers(1, &EBO);
+}
+
+/**
+* Parse a model and write its .bbmesh cache without touching GL, so large uploads can be imported on a loading
+* thread. Loading the model afterwards (through MeshManager) then only maps the cache and uploads it. If the cache
+* cannot be written the model is still fine, it is just parsed again on load.
+*
+* @param path                       [in] Path to the obj file.
+* @param onProgress                 [in] Optional, called with the fraction done.
+*
+* @return true if the model could be parsed (or is already cached).
+*/
+
+bool BeybladeMesh::importModel(const string& path, const function<void(float)>& onProgress) {
+    MeshCache cache;
+    if (cache.open(path)) {
+        if (onProgress) onProgress(1.0f);
+        return true;
+    }
+
+    BeybladeMesh mesh(path, Deferred{});
+    mesh.buildMesh([&](float parsed) { if (onProgress) onProgress(0.8f * parsed); });
+    if (!mesh.modelLoaded) return false;
+
+    mesh.saveToCache();
+    if (onProgress) onProgress(1.0f);
+    return true;
+}
+
 /**
 * NEWMESH Load the model files.
 *
@@ -31,12 +73,15 @@ using namespace glm;
 * Once the model is loaded, the radii and heights can be copied to the Beyblade object
 * so they can be more conveniently be accessed by the physics code.
 *
+* The OBJ is read by ObjParser, in parallel for large files; MTL files go through tinyobj.
+*
 * @param path                       [in] Path to the obj file.
+* @param onProgress                 [in] Optional, called with the fraction of the file parsed.
 *
 * @return true on success.  Also sets the modelLoaded field.
 */
 
-bool BeybladeMesh::loadModel(const string& path) {
+bool BeybladeMesh::loadModel(const string& path, const function<void(float)>& onProgress) {
     // Load the OBJ file...
     tinyobj::attrib_t attrib;
     vector<tinyobj::shape_t> shapes;
@@ -45,13 +90,7 @@ bool BeybladeMesh::loadModel(const string& path) {
 
     modelLoaded = false;
 
-    // Extract directory from the path
-    string baseDir = path.substr(0, path.find_last_of("/\\"));
-    if (baseDir.empty()) {
-        baseDir = ".";
-    }
-
-    bool ret = tinyobj::LoadObj(&attrib, &shapes, &materials, &warn, &err, path.c_str(), baseDir.c_str(), true, true);
+    bool ret = ObjParser::load(path, attrib, shapes, materials, warn, err, onProgress);
 
     if (!warn.empty()) {
         cout << "WARN::TINYOBJLOADER::" << warn << endl;
@@ -79,22 +118,15 @@ bool BeybladeMesh::loadModel(const string& path) {
     indices.clear();
     materialColors.clear();
 
-    unordered_map<uint32_t, glm::vec3> vertexMap;
-    unordered_map<uint32_t, glm::vec3> normalMap;
-    unordered_map<uint32_t, glm::vec2> texCoordMap;
-
-    // Extract vertices, normals, and texture coordinates...
-    for (uint32_t v = 0; v < (uint32_t)attrib.vertices.size() / 3; ++v) {
-        vertexMap[v] = glm::vec3(attrib.vertices[3 * v + 0], attrib.vertices[3 * v + 1], attrib.vertices[3 * v + 2]);
-    }
-
-    for (uint32_t n = 0; n < (uint32_t)attrib.normals.size() / 3; ++n) {
-        normalMap[n] = glm::vec3(attrib.normals[3 * n + 0], attrib.normals[3 * n + 1], attrib.normals[3 * n + 2]);
-    }
-
-    for (uint32_t t = 0; t < (uint32_t)attrib.texcoords.size() / 2; ++t) {
-        texCoordMap[t] = glm::vec2(attrib.texcoords[2 * t + 0], attrib.texcoords[2 * t + 1]);
-    }
+    // Attribute lookups read tinyobj's arrays directly. Missing normals and texture coordinates (index -1) are zero.
+    auto getNormal = [&attrib](int n) {
+        return n >= 0 && 3 * size_t(n) + 2 < attrib.normals.size()
+            ? glm::vec3(attrib.normals[3 * n + 0], attrib.normals[3 * n + 1], attrib.normals[3 * n + 2]) : glm::vec3(0.0f);
+    };
+    auto getTexCoord = [&attrib](int t) {
+        return t >= 0 && 2 * size_t(t) + 1 < attrib.texcoords.size()
+            ? glm::vec2(attrib.texcoords[2 * t + 0], attrib.texcoords[2 * t + 1]) : glm::vec2(0.0f);
+    };
 
     // Handle materials
 
@@ -126,9 +158,10 @@ bool BeybladeMesh::loadModel(const string& path) {
 
             for (size_t vertexIndex = 0; vertexIndex < 3; ++vertexIndex) {
                 auto& index = shape.mesh.indices[3 * faceIndex + vertexIndex];
-                glm::vec3 vertex = vertexMap[index.vertex_index];
-                glm::vec3 normal = normalMap.count(index.normal_index) ? normalMap[index.normal_index] : glm::vec3(0.0f, 0.0f, 0.0f);
-                glm::vec2 texCoord = texCoordMap.count(index.texcoord_index) ? texCoordMap[index.texcoord_index] : glm::vec2(0.0f, 0.0f);
+                glm::vec3 vertex(attrib.vertices[3 * index.vertex_index + 0], attrib.vertices[3 * index.vertex_index + 1],
+                    attrib.vertices[3 * index.vertex_index + 2]);
+                glm::vec3 normal = getNormal(index.normal_index);
+                glm::vec2 texCoord = getTexCoord(index.texcoord_index);
 
                 // Update bounding box for overall mesh.
 
@@ -208,18 +241,145 @@ bool BeybladeMesh::loadModel(const string& path) {
     return true;
 }
 
+/**
+* Load template part models and stack them into one mesh. loadModel() already centers each part on the y axis with
+* its base at 0, so each part only has to be raised onto the one below it. Every part keeps its own index range
+* (see getParts()), and its radius and height feed the physics like the three shape case of loadModel().
+*
+* @param paths                      [in] Paths to the part obj files, bottom first: driver, disc, layer.
+*
+* @return true on success.  Also sets the modelLoaded field.
+*/
+
+bool BeybladeMesh::loadParts(const vector<string>& paths) {
+    string combinedPath = modelPath;    // loadModel() overwrites it
+    vector<glm::vec3> stackedVertices, stackedNormals, stackedColors;
+    vector<glm::vec2> stackedTexCoords;
+    unordered_map<string, glm::vec3> stackedMaterialColors;
+    vector<MeshPart> stackedParts;
+    vector<glm::vec2> partSizes;        // Radius and height
+    BoundingBox stackedBounds;
+    float baseY = 0.0f;
+
+    for (const string& path : paths) {
+        boundingBox = BoundingBox();
+        if (!loadModel(path)) {
+            cerr << "ERROR: Could not load template part " << path << endl;
+            modelPath = combinedPath;
+            return false;
+        }
+
+        // loadModel() moved the vertices but not the x and z bounds
+        glm::vec3 halfSize = (boundingBox.max - boundingBox.min) * 0.5f;
+        stackedBounds.min = glm::min(stackedBounds.min, glm::vec3(-halfSize.x, baseY, -halfSize.z));
+        stackedBounds.max = glm::max(stackedBounds.max, glm::vec3(halfSize.x, baseY + boundingBox.max.y, halfSize.z));
+        partSizes.emplace_back(halfSize.x, boundingBox.max.y);
+
+        MeshPart part;
+        part.firstIndex = uint32_t(stackedVertices.size());     // Indices are still one per vertex
+        part.indexCount = uint32_t(vertices.size());
+        stackedParts.push_back(part);
+
+        for (const glm::vec3& v : vertices) stackedVertices.push_back(v + glm::vec3(0.0f, baseY, 0.0f));
+        stackedNormals.insert(stackedNormals.end(), normals.begin(), normals.end());
+        stackedTexCoords.insert(stackedTexCoords.end(), texCoords.begin(), texCoords.end());
+        stackedColors.insert(stackedColors.end(), colors.begin(), colors.end());
+        stackedMaterialColors.insert(materialColors.begin(), materialColors.end());
+
+        baseY += boundingBox.max.y;
+    }
+
+    vertices.swap(stackedVertices);
+    normals.swap(stackedNormals);
+    texCoords.swap(stackedTexCoords);
+    colors.swap(stackedColors);
+    materialColors.swap(stackedMaterialColors);
+    indices.resize(vertices.size());
+    iota(indices.begin(), indices.end(), 0u);
+    parts.swap(stackedParts);
+    boundingBox = stackedBounds;
+    modelPath = combinedPath;
+
+    if (partSizes.size() == 3) {
+        radiusDriver = partSizes[0].x;
+        heightDriver = partSizes[0].y;
+        radiusDisc = partSizes[1].x;
+        heightDisc = partSizes[1].y;
+        radiusLayer = partSizes[2].x;
+        heightLayer = partSizes[2].y;
+    }
+
+    modelLoaded = true;
+    return true;
+}
+
+/**
+* Weld and reorder each part on its own, so every part stays one contiguous index range.
+*
+* @param interleaved                [in/out] Vertex data, FLOATS_PER_VERTEX floats per vertex, one vertex per index.
+*
+* @return Totals over all parts.
+*/
+
+MeshOptimizeStats BeybladeMesh::optimizeParts(vector<float>& interleaved) {
+    MeshOptimizeStats stats;
+    stats.vertexCountBefore = interleaved.size() / FLOATS_PER_VERTEX;
+    stats.acmrBefore = computeACMR(indices, stats.vertexCountBefore);
+
+    vector<float> optimizedVertices;
+    vector<uint32_t> optimizedIndices;
+    for (MeshPart& part : parts) {
+        auto first = interleaved.begin() + size_t(part.firstIndex) * FLOATS_PER_VERTEX;
+        vector<float> partVertices(first, first + size_t(part.indexCount) * FLOATS_PER_VERTEX);
+        vector<uint32_t> partIndices(part.indexCount);
+        iota(partIndices.begin(), partIndices.end(), 0u);
+        optimizeMesh(partVertices, FLOATS_PER_VERTEX, partIndices);
+
+        uint32_t baseVertex = uint32_t(optimizedVertices.size() / FLOATS_PER_VERTEX);
+        part.firstIndex = uint32_t(optimizedIndices.size());
+        part.indexCount = uint32_t(partIndices.size());
+        for (uint32_t index : partIndices) optimizedIndices.push_back(baseVertex + index);
+        optimizedVertices.insert(optimizedVertices.end(), partVertices.begin(), partVertices.end());
+    }
+
+    interleaved.swap(optimizedVertices);
+    indices.swap(optimizedIndices);
+    stats.vertexCountAfter = interleaved.size() / FLOATS_PER_VERTEX;
+    stats.acmrAfter = computeACMR(indices, stats.vertexCountAfter);
+    return stats;
+}
+
 /**
 * Internal routine to initialize the mesh.
 */
 
 void BeybladeMesh::updateMesh() {
-    loadModel(modelPath);
+    if (loadFromCache()) return;
+    if (!buildMesh()) return;
+
+    setupBuffers(VAO, VBO, EBO, vertexData.data(), vertexData.size() * sizeof(PackedVertex), indices.data(),
+        indices.size() * sizeof(uint32_t), PACKED_VERTEX_LAYOUT);
+
+    if (modelLoaded) saveToCache();
+}
+
+/**
+* The CPU half of updateMesh(): load the model and fill vertexData and indices. No GL calls.
+*
+* @param onProgress                 [in] Optional, called with the fraction of the model parsed.
+*
+* @return false if the loaded data is inconsistent.
+*/
+
+bool BeybladeMesh::buildMesh(const function<void(float)>& onProgress) {
+    if (partPaths.empty()) loadModel(modelPath, onProgress);
+    else loadParts(partPaths);
 
     if (vertices.size() != normals.size() || vertices.size() != texCoords.size()) {
         cerr << "Mesh data is inconsistent" << endl;
         cout << "Vertices: " << vertices.size() << ", Normals: " << normals.size() << ", TexCoords: "
             << texCoords.size() << endl;
-        return;
+        return false;
     }
 
     // Ensure colors vector has the same size as vertices if colors are not present
@@ -228,49 +388,134 @@ void BeybladeMesh::updateMesh() {
         cout << "SET TO ALL WHITE" << endl;
     }
 
+    // Interleaved as floats so welding compares exact values; packed afterwards
+    vector<float> interleaved;
     for (size_t i = 0; i < vertices.size(); ++i) {
         // Vertex positions
-        vertexData.push_back(vertices[i].x);
-        vertexData.push_back(vertices[i].y);
-        vertexData.push_back(vertices[i].z);
+        interleaved.push_back(vertices[i].x);
+        interleaved.push_back(vertices[i].y);
+        interleaved.push_back(vertices[i].z);
 
         // Normal data
-        vertexData.push_back(normals[i].x);
-        vertexData.push_back(normals[i].y);
-        vertexData.push_back(normals[i].z);
+        interleaved.push_back(normals[i].x);
+        interleaved.push_back(normals[i].y);
+        interleaved.push_back(normals[i].z);
 
         // Texture coordinates (if available)
         if (!texCoords.empty()) {
-            vertexData.push_back(texCoords[i].x);
-            vertexData.push_back(texCoords[i].y);
+            interleaved.push_back(texCoords[i].x);
+            interleaved.push_back(texCoords[i].y);
         }
         else {
-            vertexData.push_back(0.0f);
-            vertexData.push_back(0.0f);
+            interleaved.push_back(0.0f);
+            interleaved.push_back(0.0f);
         }
 
         // Color data
-        vertexData.push_back(colors[i].x);
-        vertexData.push_back(colors[i].y);
-        vertexData.push_back(colors[i].z);
+        interleaved.push_back(colors[i].x);
+        interleaved.push_back(colors[i].y);
+        interleaved.push_back(colors[i].z);
+    }
+
+    // The OBJ gives every face corner its own vertex. Weld identical ones and reorder for the GPU caches.
+    // The per-corner arrays no longer match the indices afterwards, so they are dropped.
+    if (modelLoaded) {
+        MeshOptimizeStats stats = parts.empty() ? optimizeMesh(interleaved, FLOATS_PER_VERTEX, indices) : optimizeParts(interleaved);
+        ostringstream oss;
+        oss << fixed << setprecision(2) << "Model " << modelPath << " welded from " << stats.vertexCountBefore << " to "
+            << stats.vertexCountAfter << " vertices, ACMR " << stats.acmrBefore << " -> " << stats.acmrAfter;
+        MessageLog::getInstance().addMessage(oss.str(), MessageType::NORMAL);
+
+        vector<glm::vec3>().swap(vertices);
+        vector<glm::vec3>().swap(normals);
+        vector<glm::vec2>().swap(texCoords);
+        vector<glm::vec3>().swap(colors);
     }
-    setupBuffers(VAO, VBO, EBO, vertexData.data(), vertexData.size() * sizeof(float), indices.data(),
-        indices.size() * sizeof(uint32_t), { 3, 3, 2, 3 });
+
+    vertexData.clear();
+    vertexData.reserve(interleaved.size() / FLOATS_PER_VERTEX);
+    for (size_t i = 0; i + FLOATS_PER_VERTEX <= interleaved.size(); i += FLOATS_PER_VERTEX) {
+        const float* v = &interleaved[i];
+        vertexData.push_back(packVertex(glm::vec3(v[0], v[1], v[2]), glm::vec3(v[3], v[4], v[5]), glm::vec2(v[6], v[7]),
+            glm::vec3(v[8], v[9], v[10])));
+    }
+    indexCount = indices.size();
+    return true;
 }
 
-void BeybladeMesh::printDebugInfo() {
-    ostringstream buffer;
-    buffer << "Vertices: " << vertices.size() << endl;
-    for (const auto& vertex : vertices) {
-        buffer << fixed << setprecision(2) << "(" << vertex.x << ", " << vertex.y << ", " << vertex.z << ") ";
+/**
+* Load the mesh from its .bbmesh cache if it is present and up to date. The GPU buffers are filled straight from
+* the mapped file, so the CPU-side vertex arrays stay empty.
+*
+* @return true if the mesh was loaded, false if the OBJ needs to be parsed.
+*/
+
+bool BeybladeMesh::loadFromCache() {
+    MeshCache cache;
+    if (!(partPaths.empty() ? cache.open(modelPath) : cache.open(partPaths, modelPath))) return false;
+
+    const MeshCacheContents& contents = cache.getContents();
+    if (contents.vertexStride != sizeof(PackedVertex)) return false;
+
+    boundingBox.min = contents.boundsMin;
+    boundingBox.max = contents.boundsMax;
+    radiusDisc = contents.radiusDisc;
+    radiusLayer = contents.radiusLayer;
+    radiusDriver = contents.radiusDriver;
+    heightDisc = contents.heightDisc;
+    heightLayer = contents.heightLayer;
+    heightDriver = contents.heightDriver;
+    materialColors = contents.materialColors;
+    parts = contents.parts;
+
+    setupBuffers(VAO, VBO, EBO, contents.vertexData, size_t(contents.vertexCount) * sizeof(PackedVertex), contents.indices,
+        size_t(contents.indexCount) * sizeof(uint32_t), PACKED_VERTEX_LAYOUT);
+    indexCount = contents.indexCount;
+
+    MessageLog::getInstance().addMessage("Model " + modelPath + " loaded from cache with " + to_string(contents.vertexCount) + " vertices and "
+        + to_string(contents.indexCount) + " indices.", MessageType::NORMAL);
+    modelLoaded = true;
+    return true;
+}
+
+/**
+* Write the processed mesh to its .bbmesh cache. Failure (e.g. a read-only install) only costs the next load time.
+*/
+
+void BeybladeMesh::saveToCache() const {
+    MeshCacheContents contents;
+    contents.vertexData = vertexData.data();
+    contents.vertexStride = sizeof(PackedVertex);
+    contents.vertexCount = uint32_t(vertexData.size());
+    contents.indices = indices.data();
+    contents.indexCount = uint32_t(indices.size());
+    contents.materialColors = materialColors;
+    contents.parts = parts;
+    contents.boundsMin = boundingBox.min;
+    contents.boundsMax = boundingBox.max;
+    contents.radiusDisc = radiusDisc;
+    contents.radiusLayer = radiusLayer;
+    contents.radiusDriver = radiusDriver;
+    contents.heightDisc = heightDisc;
+    contents.heightLayer = heightLayer;
+    contents.heightDriver = heightDriver;
+
+    if (partPaths.empty()) {
+        if (!MeshCache::write(modelPath, contents)) {
+            cerr << "Warning: Could not write mesh cache " << MeshCache::getCachePath(modelPath) << endl;
+        }
     }
-    buffer << "\nNormals: " << normals.size() << endl;
-    for (const auto& normal : normals) {
-        buffer << fixed << setprecision(2) << "(" << normal.x << ", " << normal.y << ", " << normal.z << ") ";
+    else if (!MeshCache::write(partPaths, modelPath, contents)) {
+        cerr << "Warning: Could not write mesh cache " << modelPath << endl;
     }
-    buffer << "\nTexture Coordinates: " << texCoords.size() << endl;
-    for (const auto& texCoord : texCoords) {
-        buffer << fixed << setprecision(2) << "(" << texCoord.x << ", " << texCoord.y << ") ";
+}
+
+void BeybladeMesh::printDebugInfo() {
+    ostringstream buffer;
+    // Positions of the welded vertices; the other attributes are packed
+    buffer << "Vertices: " << vertexData.size() << endl;
+    for (const PackedVertex& vertex : vertexData) {
+        buffer << fixed << setprecision(2) << "(" << vertex.position[0] << ", " << vertex.position[1] << ", " << vertex.position[2] << ") ";
     }
     buffer << "\nIndices: " << indices.size() << endl;
     for (size_t i = 0; i < indices.size(); i += 3) {
@@ -291,7 +536,7 @@ void BeybladeMesh::render(ObjectShader& shader) {
     //glPolygonMode(GL_FRONT_AND_BACK, GL_LINE); // Switch to wireframe mode
 
     glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, (GLsizei)indices.size(), GL_UNSIGNED_INT, nullptr);
+    glDrawElements(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, nullptr);
     glBindVertexArray(0);
 
     //shader.use();
@@ -306,4 +551,40 @@ void BeybladeMesh::render(ObjectShader& shader) {
     while ((err = glGetError()) != GL_NO_ERROR) {
         cerr << "OpenGL error in BeybladeMesh: " << err << endl;
     }
-}
\ No newline at end of file
+}
+
+/**
+* Draw many copies of the mesh with one draw call. The shader must have "instanced" set (see InstanceBatch).
+*
+* The instance data is pushed to the StreamBuffer and locations 4-8 of this mesh's VAO are pointed at it.
+*
+* @param shader                     [in] Object shader.
+* @param instances                  [in] Model matrix and tint of each copy.
+* @param count                      [in] Number of copies.
+*/
+
+void BeybladeMesh::renderInstanced(ObjectShader& shader, const InstanceData* instances, size_t count) {
+    if (count == 0) return;
+
+    StreamBuffer& stream = StreamBuffer::getInstance();
+    uintptr_t offset = stream.push(instances, count * sizeof(InstanceData), sizeof(InstanceData));
+
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, stream.getBuffer());
+
+    // A mat4 attribute takes four consecutive locations, one per column
+    for (GLuint column = 0; column < 4; ++column) {
+        glVertexAttribPointer(4 + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+            (void*)(offset + offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(4 + column);
+        glVertexAttribDivisor(4 + column, 1);
+    }
+    glVertexAttribPointer(8, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(offset + offsetof(InstanceData, tint)));
+    glEnableVertexAttribArray(8);
+    glVertexAttribDivisor(8, 1);
+
+    glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)indexCount, GL_UNSIGNED_INT, nullptr, (GLsizei)count);
+
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    glBindVertexArray(0);
+}
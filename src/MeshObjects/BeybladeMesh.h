@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include <functional>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -13,29 +14,49 @@
 #include <glm/glm.hpp>
 
 #include "BoundingBox.h"
+#include "Buffers.h"
+#include "BeybladeTemplatePath.h"
+#include "MeshCache.h"
+#include "MeshOptimizer.h"
 
 class ObjectShader;
+struct InstanceData;
 
-// Need to call loadModel and updateMesh for using the mesh
+// Need to call loadModel and updateMesh for using the mesh. Get shared instances through MeshManager.
 class BeybladeMesh {
 public:
     BeybladeMesh(std::string& modelPath, unsigned int vao, unsigned int vbo, unsigned int ebo, glm::vec3& tint = glm::vec3(1.0f))
         : modelPath(std::move(modelPath)), VAO(vao), VBO(vbo), EBO(ebo), tint(tint) {
         updateMesh();
     }
-    BeybladeMesh(const char* path = "./assets/models/default.obj") : modelPath(path), VAO(0), VBO(0), EBO(0), tint(glm::vec3(1.0f)) {
+    BeybladeMesh(const char* path = DEFAULT_MODEL_PATH) : modelPath(path), VAO(0), VBO(0), EBO(0), tint(glm::vec3(1.0f)) {
         updateMesh();
     }
+    // Template parts stacked into one mesh, bottom first: driver, disc, layer. Cached at cachePath, see loadParts()
+    BeybladeMesh(const std::vector<std::string>& partPaths, const std::string& cachePath)
+        : modelPath(cachePath), partPaths(partPaths), VAO(0), VBO(0), EBO(0), tint(glm::vec3(1.0f)) {
+        updateMesh();
+    }
+    ~BeybladeMesh();
+
+    // Owns GL objects
+    BeybladeMesh(const BeybladeMesh&) = delete;
+    BeybladeMesh& operator=(const BeybladeMesh&) = delete;
 
-    bool loadModel(const std::string& path);
+    static bool importModel(const std::string& path, const std::function<void(float)>& onProgress = nullptr);
+
+    bool loadModel(const std::string& path, const std::function<void(float)>& onProgress = nullptr);
+    bool loadParts(const std::vector<std::string>& paths);
     const std::string& getModelPath() const { return modelPath; }
     void printDebugInfo();
 
-    //unsigned int getVAO() const { return VAO; }
+    unsigned int getVAO() const { return VAO; }
+    const std::vector<MeshPart>& getParts() const { return parts; }    // Index ranges, in partPaths order
     //int getIndicesSize() { return static_cast<int>(indices.size()); }
     //std::unordered_map<std::string, glm::vec3>& getMaterialColors() { return materialColors; }
 
     void render(ObjectShader& shader);
+    void renderInstanced(ObjectShader& shader, const InstanceData* instances, size_t count);
 
     BoundingBox boundingBox{};                          // Mesh bounding box.
     float heightDisc{}, heightLayer{}, heightDriver{};  // Heights of subparts
@@ -53,12 +74,25 @@ private:
     std::vector<glm::vec3> tangents;
 
     std::unordered_map<std::string, glm::vec3> materialColors;
-    std::string modelPath;
+    std::string modelPath;                          // The .bbmesh path for a combined mesh
+    std::vector<std::string> partPaths;             // Empty unless combined from template parts
+    std::vector<MeshPart> parts;
 
     std::vector<glm::vec3> colors;
-    std::vector<float> vertexData;
+    std::vector<PackedVertex> vertexData;           // Empty when loaded from the .bbmesh cache
+    size_t indexCount = 0;                          // Valid either way
+
+    static constexpr uint32_t FLOATS_PER_VERTEX = 11;   // Before packing: position, normal, texture coordinates, color
 
     unsigned int VAO{}, VBO{}, EBO{};
 
+    // Skips updateMesh(), for importModel()
+    struct Deferred {};
+    BeybladeMesh(const std::string& path, Deferred) : modelPath(path), VAO(0), VBO(0), EBO(0), tint(glm::vec3(1.0f)) {}
+
     void updateMesh();
+    bool buildMesh(const std::function<void(float)>& onProgress = nullptr);
+    MeshOptimizeStats optimizeParts(std::vector<float>& interleaved);
+    bool loadFromCache();
+    void saveToCache() const;
 };
\ No newline at end of file
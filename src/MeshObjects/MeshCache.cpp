@@ -0,0 +1,322 @@
+////////////////////////////////////////////////////////////////////////////////
+// MeshCache.cpp -- Binary .bbmesh model cache -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "MeshCache.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct MeshCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;        // FNV-1a of the OBJ and MTL contents
+    uint64_t sourceStamp;       // FNV-1a of their sizes and modification times, checked before the hash
+    uint32_t vertexStride;      // Bytes
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t materialCount;
+    uint32_t mtlCount;          // MTL file paths stored after the materials
+    uint32_t partCount;         // Part index ranges stored after the MTL paths
+    float boundsMin[3];
+    float boundsMax[3];
+    float radiusDisc, radiusLayer, radiusDriver;
+    float heightDisc, heightLayer, heightDriver;
+};
+
+constexpr char MESH_CACHE_MAGIC[4] = { 'B', 'B', 'M', 'S' };
+constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+size_t padTo4(size_t size) {
+    return (size + 3) & ~size_t(3);
+}
+
+/**
+* MTL files named by mtllib lines in the OBJs, as paths next to the OBJ naming them.
+*/
+vector<string> findMtlFiles(const vector<string>& modelPaths) {
+    vector<string> mtlPaths;
+    for (const string& modelPath : modelPaths) {
+        ifstream obj(modelPath);
+        string line;
+        while (getline(obj, line)) {
+            if (line.compare(0, 7, "mtllib ") != 0) continue;
+            istringstream words(line.substr(7));
+            string name;
+            while (words >> name) mtlPaths.push_back((fs::path(modelPath).parent_path() / name).generic_string());
+        }
+    }
+    return mtlPaths;
+}
+
+vector<fs::path> getSourcePaths(const vector<string>& modelPaths, const vector<string>& mtlPaths) {
+    vector<fs::path> paths(modelPaths.begin(), modelPaths.end());
+    paths.insert(paths.end(), mtlPaths.begin(), mtlPaths.end());
+    return paths;
+}
+
+bool computeStamp(const vector<fs::path>& paths, uint64_t& stamp) {
+    error_code ec;
+    stamp = FNV_OFFSET;
+    for (const fs::path& path : paths) {
+        uint64_t size = fs::file_size(path, ec);
+        if (ec) return false;
+        int64_t time = fs::last_write_time(path, ec).time_since_epoch().count();
+        if (ec) return false;
+        stamp = fnv1a(stamp, &size, sizeof(size));
+        stamp = fnv1a(stamp, &time, sizeof(time));
+    }
+    return true;
+}
+
+bool computeHash(const vector<fs::path>& paths, uint64_t& hash) {
+    hash = FNV_OFFSET;
+    vector<char> buffer(1 << 16);
+    for (const fs::path& path : paths) {
+        ifstream file(path, ios::binary);
+        if (!file) return false;
+        while (file) {
+            file.read(buffer.data(), buffer.size());
+            hash = fnv1a(hash, buffer.data(), size_t(file.gcount()));
+        }
+    }
+    return true;
+}
+
+// Bounds-checked reader over the mapped file
+struct CacheReader {
+    const unsigned char* data;
+    size_t size;
+    size_t offset = 0;
+
+    const unsigned char* take(size_t count) {
+        if (count > size - offset) return nullptr;
+        const unsigned char* result = data + offset;
+        offset += padTo4(count);
+        if (offset > size) offset = size;
+        return result;
+    }
+    bool readString(string& out) {
+        const unsigned char* length = take(sizeof(uint32_t));
+        if (length == nullptr) return false;
+        uint32_t count;
+        memcpy(&count, length, sizeof(count));
+        const unsigned char* chars = take(count);
+        if (chars == nullptr) return false;
+        out.assign(reinterpret_cast<const char*>(chars), count);
+        return true;
+    }
+};
+
+void writeString(ofstream& out, const string& text) {
+    static const char zeros[4] = {};
+    uint32_t length = uint32_t(text.size());
+    out.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.write(text.data(), text.size());
+    out.write(zeros, padTo4(text.size()) - text.size());
+}
+
+}  // namespace
+
+/**
+* Where the cache for a model lives: next to it, with a .bbmesh extension.
+*/
+
+string MeshCache::getCachePath(const string& modelPath) {
+    return fs::path(modelPath).replace_extension(".bbmesh").string();
+}
+
+/**
+* Map the cache for a model if it exists and matches the current OBJ and MTL files.
+*
+* @param modelPath              [in] Path to the .obj file.
+*
+* @return true if getContents() can be used.
+*/
+
+bool MeshCache::open(const string& modelPath) {
+    return open(vector<string>{ modelPath }, getCachePath(modelPath));
+}
+
+/**
+* Map the cache for a mesh combined from several models if it exists and matches all of their OBJ and MTL files.
+*
+* @param modelPaths             [in] Paths to the .obj files, in the order they were combined.
+* @param cachePath              [in] Path to the .bbmesh file.
+*
+* @return true if getContents() can be used.
+*/
+
+bool MeshCache::open(const vector<string>& modelPaths, const string& cachePath) {
+    close();
+    if (!file.open(cachePath)) return false;
+
+    CacheReader reader{ file.getData(), file.getSize() };
+    const unsigned char* headerData = reader.take(sizeof(MeshCacheHeader));
+    if (headerData == nullptr) {
+        close();
+        return false;
+    }
+    MeshCacheHeader header;
+    memcpy(&header, headerData, sizeof(header));
+    if (memcmp(header.magic, MESH_CACHE_MAGIC, sizeof(header.magic)) != 0 || header.version != VERSION) {
+        close();
+        return false;
+    }
+
+    // The mapping is page aligned and every section starts on a 4 byte boundary, so these can be used in place
+    contents.vertexStride = header.vertexStride;
+    contents.vertexCount = header.vertexCount;
+    contents.vertexData = reader.take(size_t(header.vertexCount) * header.vertexStride);
+    contents.indexCount = header.indexCount;
+    contents.indices = reinterpret_cast<const uint32_t*>(reader.take(size_t(header.indexCount) * sizeof(uint32_t)));
+    bool valid = contents.vertexData != nullptr && contents.indices != nullptr;
+
+    for (uint32_t m = 0; valid && m < header.materialCount; ++m) {
+        string name;
+        const unsigned char* color = nullptr;
+        valid = reader.readString(name) && (color = reader.take(sizeof(float) * 3)) != nullptr;
+        if (valid) memcpy(&contents.materialColors[name], color, sizeof(float) * 3);
+    }
+
+    vector<string> mtlPaths(header.mtlCount);
+    for (uint32_t i = 0; valid && i < header.mtlCount; ++i) {
+        valid = reader.readString(mtlPaths[i]);
+    }
+
+    contents.parts.resize(header.partCount);
+    for (uint32_t i = 0; valid && i < header.partCount; ++i) {
+        const unsigned char* part = reader.take(sizeof(MeshPart));
+        valid = part != nullptr;
+        if (valid) memcpy(&contents.parts[i], part, sizeof(MeshPart));
+    }
+
+    // Unchanged sizes and times are trusted; otherwise the contents decide
+    if (valid) {
+        vector<fs::path> sources = getSourcePaths(modelPaths, mtlPaths);
+        uint64_t stamp, hash;
+        if (!computeStamp(sources, stamp)) valid = false;
+        else if (stamp != header.sourceStamp) valid = computeHash(sources, hash) && hash == header.sourceHash;
+    }
+
+    if (!valid) {
+        close();
+        return false;
+    }
+
+    contents.boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    contents.boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    contents.radiusDisc = header.radiusDisc;
+    contents.radiusLayer = header.radiusLayer;
+    contents.radiusDriver = header.radiusDriver;
+    contents.heightDisc = header.heightDisc;
+    contents.heightLayer = header.heightLayer;
+    contents.heightDriver = header.heightDriver;
+    return true;
+}
+
+void MeshCache::close() {
+    file.close();
+    contents = MeshCacheContents();
+}
+
+/**
+* Write the cache for a model. Written to a temporary file and renamed, so a crash never leaves a torn cache.
+*
+* @param modelPath              [in] Path to the .obj file the contents came from.
+* @param contents               [in] Processed mesh.
+*
+* @return false if the sources cannot be read or the cache cannot be written (e.g. a read-only install).
+*/
+
+bool MeshCache::write(const string& modelPath, const MeshCacheContents& contents) {
+    return write(vector<string>{ modelPath }, getCachePath(modelPath), contents);
+}
+
+/**
+* Write the cache for a mesh combined from several models, creating its directory if needed.
+*
+* @param modelPaths             [in] Paths to the .obj files, in the order they were combined.
+* @param cachePath              [in] Path to the .bbmesh file.
+* @param contents               [in] Processed mesh.
+*
+* @return false if the sources cannot be read or the cache cannot be written.
+*/
+
+bool MeshCache::write(const vector<string>& modelPaths, const string& cachePath, const MeshCacheContents& contents) {
+    vector<string> mtlPaths = findMtlFiles(modelPaths);
+    vector<fs::path> sources = getSourcePaths(modelPaths, mtlPaths);
+
+    MeshCacheHeader header{};
+    memcpy(header.magic, MESH_CACHE_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    if (!computeStamp(sources, header.sourceStamp) || !computeHash(sources, header.sourceHash)) return false;
+    header.vertexStride = contents.vertexStride;
+    header.vertexCount = contents.vertexCount;
+    header.indexCount = contents.indexCount;
+    header.materialCount = uint32_t(contents.materialColors.size());
+    header.mtlCount = uint32_t(mtlPaths.size());
+    header.partCount = uint32_t(contents.parts.size());
+    for (int i = 0; i < 3; ++i) {
+        header.boundsMin[i] = contents.boundsMin[i];
+        header.boundsMax[i] = contents.boundsMax[i];
+    }
+    header.radiusDisc = contents.radiusDisc;
+    header.radiusLayer = contents.radiusLayer;
+    header.radiusDriver = contents.radiusDriver;
+    header.heightDisc = contents.heightDisc;
+    header.heightLayer = contents.heightLayer;
+    header.heightDriver = contents.heightDriver;
+
+    error_code ec;
+    fs::path cacheDir = fs::path(cachePath).parent_path();
+    if (!cacheDir.empty()) fs::create_directories(cacheDir, ec);
+
+    string tempPath = cachePath + ".tmp";
+    {
+        ofstream out(tempPath, ios::binary | ios::trunc);
+        if (!out) return false;
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(contents.vertexData), size_t(contents.vertexCount) * contents.vertexStride);
+        out.write(reinterpret_cast<const char*>(contents.indices), size_t(contents.indexCount) * sizeof(uint32_t));
+        for (const auto& [name, color] : contents.materialColors) {
+            writeString(out, name);
+            out.write(reinterpret_cast<const char*>(&color[0]), sizeof(float) * 3);
+        }
+        for (const string& path : mtlPaths) writeString(out, path);
+        for (const MeshPart& part : contents.parts) out.write(reinterpret_cast<const char*>(&part), sizeof(part));
+
+        if (!out) {
+            out.close();
+            remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,71 @@
+////////////////////////////////////////////////////////////////////////////////
+// MeshCache.h -- Binary .bbmesh model cache include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "MappedFile.h"
+
+// Index range of one template part in a combined mesh, see BeybladeMesh::getParts()
+struct MeshPart {
+    uint32_t firstIndex = 0;
+    uint32_t indexCount = 0;
+};
+
+/**
+* Everything BeybladeMesh needs from a model once the OBJ has been parsed. When read from a cache, the vertex and
+* index pointers point into the mapped file and are only valid while the MeshCache is open.
+*/
+struct MeshCacheContents {
+    const void* vertexData = nullptr;       // Interleaved, vertexStride bytes per vertex
+    uint32_t vertexStride = 0;
+    uint32_t vertexCount = 0;
+    const uint32_t* indices = nullptr;
+    uint32_t indexCount = 0;
+
+    std::unordered_map<std::string, glm::vec3> materialColors;
+    std::vector<MeshPart> parts;            // Empty unless combined from several models
+
+    glm::vec3 boundsMin{};
+    glm::vec3 boundsMax{};
+    float radiusDisc = 0.0f, radiusLayer = 0.0f, radiusDriver = 0.0f;
+    float heightDisc = 0.0f, heightLayer = 0.0f, heightDriver = 0.0f;
+};
+
+/**
+* A .bbmesh file stored next to an OBJ (model.obj -> model.bbmesh), holding the processed mesh so loading is a
+* single map of the file instead of text parsing.
+*
+* The cache records the sizes and modification times of the OBJ and its MTL files, plus a hash of their contents.
+* If the sizes or times differ, the hash is recomputed, and the cache is only used if the contents still match.
+* Bump VERSION whenever the layout or the mesh processing changes.
+*
+* A mesh combined from several OBJs (a template's parts) is cached the same way, under a path chosen by the caller,
+* and is rebuilt when any of its sources changes.
+*/
+class MeshCache {
+public:
+    static constexpr uint32_t VERSION = 5;
+
+    static std::string getCachePath(const std::string& modelPath);
+
+    bool open(const std::string& modelPath);
+    bool open(const std::vector<std::string>& modelPaths, const std::string& cachePath);
+    void close();
+    const MeshCacheContents& getContents() const { return contents; }
+
+    static bool write(const std::string& modelPath, const MeshCacheContents& contents);
+    static bool write(const std::vector<std::string>& modelPaths, const std::string& cachePath, const MeshCacheContents& contents);
+
+private:
+    MappedFile file;
+    MeshCacheContents contents;
+};
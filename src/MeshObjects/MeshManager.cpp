@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// MeshManager.cpp -- Shared beyblade mesh registry -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+
+#include "MeshManager.h"
+
+#include "BeybladeTemplate.h"
+#include "BeybladeTemplatePath.h"
+
+using namespace std;
+
+MeshManager& MeshManager::getInstance() {
+    static MeshManager instance;
+    return instance;
+}
+
+/**
+* Get the mesh for a model file, loading it if no beyblade is using it yet.
+*
+* @param modelPath              [in] Path to the .obj file.
+*
+* @return The shared mesh. Check modelLoaded for failure.
+*/
+
+shared_ptr<BeybladeMesh> MeshManager::getMesh(const string& modelPath) {
+    lock_guard<std::mutex> lock(mutex);
+    return findOrLoad(modelPath, modelPath);
+}
+
+/**
+* Get the mesh for a template beyblade built from the given parts: the driver, disc and layer models stacked into
+* one mesh. The first request for a combination reads its .bbmesh in TEMPLATE_CACHE_DIR, or combines the three
+* OBJs and writes it; later requests return the same mesh.
+*
+* @param layerIndex             [in] Index into templateLayers.
+* @param discIndex              [in] Index into templateDiscs.
+* @param driverIndex            [in] Index into templateDrivers.
+*
+* @return The shared mesh. If a part is missing or fails to load, the default model.
+*/
+
+shared_ptr<BeybladeMesh> MeshManager::getTemplateMesh(int layerIndex, int discIndex, int driverIndex) {
+    string key = to_string(layerIndex) + "_" + to_string(discIndex) + "_" + to_string(driverIndex);
+
+    lock_guard<std::mutex> lock(mutex);
+    auto it = templateMeshes.find(key);
+    if (it != templateMeshes.end()) return it->second;
+
+    if (layerIndex < 0 || layerIndex >= int(templateLayers.size()) || discIndex < 0 || discIndex >= int(templateDiscs.size())
+        || driverIndex < 0 || driverIndex >= int(templateDrivers.size())) {
+        cerr << "Invalid template parts " << key << ", using the default model" << endl;
+        return findOrLoad(DEFAULT_MODEL_PATH, DEFAULT_MODEL_PATH);
+    }
+
+    vector<string> partPaths = { templateDrivers[driverIndex].modelPath, templateDiscs[discIndex].modelPath,
+        templateLayers[layerIndex].modelPath };
+    shared_ptr<BeybladeMesh> mesh = make_shared<BeybladeMesh>(partPaths, string(TEMPLATE_CACHE_DIR) + "/template_" + key + ".bbmesh");
+    if (!mesh->modelLoaded) {
+        cerr << "Could not combine template parts " << key << ", using the default model" << endl;
+        return findOrLoad(DEFAULT_MODEL_PATH, DEFAULT_MODEL_PATH);
+    }
+    templateMeshes[key] = mesh;
+    return mesh;
+}
+
+/**
+* Number of meshes currently alive, i.e. unique models on the GPU. Template meshes are counted by getTemplateCount().
+*/
+
+size_t MeshManager::getLiveCount() const {
+    lock_guard<std::mutex> lock(mutex);
+    size_t count = 0;
+    for (const auto& [key, mesh] : meshes) {
+        if (!mesh.expired()) ++count;
+    }
+    return count;
+}
+
+/**
+* Number of template part combinations built so far.
+*/
+
+size_t MeshManager::getTemplateCount() const {
+    lock_guard<std::mutex> lock(mutex);
+    return templateMeshes.size();
+}
+
+/**
+* Forget all meshes. Meshes still held by beyblades stay alive, but later requests load new copies. Call while the
+* GL context is current, since this may free the template meshes.
+*/
+
+void MeshManager::clear() {
+    lock_guard<std::mutex> lock(mutex);
+    meshes.clear();
+    templateMeshes.clear();
+}
+
+// Caller holds the mutex
+shared_ptr<BeybladeMesh> MeshManager::findOrLoad(const string& key, const string& modelPath) {
+    auto it = meshes.find(key);
+    if (it != meshes.end()) {
+        if (shared_ptr<BeybladeMesh> mesh = it->second.lock()) return mesh;
+    }
+
+    shared_ptr<BeybladeMesh> mesh = make_shared<BeybladeMesh>(modelPath.c_str());  // This loads the mesh.
+    if (mesh->modelLoaded) meshes[key] = mesh;
+    else meshes.erase(key);
+    return mesh;
+}
@@ -0,0 +1,48 @@
+////////////////////////////////////////////////////////////////////////////////
+// MeshManager.h -- Shared beyblade mesh registry include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "BeybladeMesh.h"
+
+/**
+* Hands out shared BeybladeMeshes, so a model is parsed and uploaded to the GPU once no matter how many
+* beyblades use it. Only weak references are kept: a mesh is freed when the last beyblade using it lets go,
+* and is loaded again the next time it is asked for.
+*
+* Template meshes, combined from their layer, disc and driver models, are the exception: they are built on first
+* use, also cached on disk, and kept until clear() so switching parts back and forth never rebuilds them.
+*
+* Meshes that fail to load are returned (with modelLoaded false) but not cached.
+*/
+class MeshManager {
+public:
+    static MeshManager& getInstance();
+
+    // Deleted for singleton
+    MeshManager(const MeshManager&) = delete;
+    MeshManager& operator=(const MeshManager&) = delete;
+
+    std::shared_ptr<BeybladeMesh> getMesh(const std::string& modelPath);
+    std::shared_ptr<BeybladeMesh> getTemplateMesh(int layerIndex, int discIndex, int driverIndex);
+
+    size_t getLiveCount() const;
+    size_t getTemplateCount() const;
+    void clear();
+
+private:
+    MeshManager() = default;
+
+    std::shared_ptr<BeybladeMesh> findOrLoad(const std::string& key, const std::string& modelPath);
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<BeybladeMesh>> meshes;    // Keyed by model path
+    std::unordered_map<std::string, std::shared_ptr<BeybladeMesh>> templateMeshes;  // Keyed by template indices
+};
@@ -1,5 +1,6 @@
 #include "MeshObject.h"
 #include "Buffers.h"
+#include "RenderQueue.h"
 
 #include "Utils.h" // DEBUGGING
 
@@ -7,6 +8,27 @@ using namespace std;
 
 MeshObject::MeshObject() : VAO(0), VBO(0), EBO(0) {}
 
+MeshObject::MeshObject(const MeshObject& other)
+    : VAO(0), VBO(0), EBO(0), vertices(other.vertices), normals(other.normals), texCoords(other.texCoords),
+    colors(other.colors), indices(other.indices), modelMatrix(other.modelMatrix), tint(other.tint),
+    boundsMin(other.boundsMin), boundsMax(other.boundsMax) {}
+
+// Keeps this object's GL names; the caller refills them with updateMesh()
+MeshObject& MeshObject::operator=(const MeshObject& other) {
+    if (this != &other) {
+        vertices = other.vertices;
+        normals = other.normals;
+        texCoords = other.texCoords;
+        colors = other.colors;
+        indices = other.indices;
+        modelMatrix = other.modelMatrix;
+        tint = other.tint;
+        boundsMin = other.boundsMin;
+        boundsMax = other.boundsMax;
+    }
+    return *this;
+}
+
 MeshObject::~MeshObject() noexcept {
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
@@ -15,48 +37,28 @@ MeshObject::~MeshObject() noexcept {
 
 
 void MeshObject::setupBuffersFromMembers() {
-    std::vector<float> vertexData;
+    std::vector<PackedVertex> vertexData;
+    vertexData.reserve(vertices.size());
     for (size_t i = 0; i < vertices.size(); ++i) {
-        // Position (x, y, z)
-        vertexData.push_back(vertices[i].x);
-        vertexData.push_back(vertices[i].y);
-        vertexData.push_back(vertices[i].z);
-
-        // Normal (x, y, z) - Ensure normals are populated in the derived class
-        if (i < normals.size()) {
-            vertexData.push_back(normals[i].x);
-            vertexData.push_back(normals[i].y);
-            vertexData.push_back(normals[i].z);
-        }
-        else {
-            vertexData.insert(vertexData.end(), { 0.0f, 0.0f, 0.0f });
-        }
-
-        // Texture Coordinates (u, v)
-        if (i < texCoords.size()) {
-            vertexData.push_back(texCoords[i].x);
-            vertexData.push_back(texCoords[i].y);
-        }
-        else {
-            vertexData.insert(vertexData.end(), { 0.0f, 0.0f });
-        }
-
-        // **Colors (r, g, b)**
-        if (i < colors.size()) {
-            vertexData.push_back(colors[i].x);
-            vertexData.push_back(colors[i].y);
-            vertexData.push_back(colors[i].z);
-        }
-        else {
-            vertexData.insert(vertexData.end(), { 1.0f, 1.0f, 1.0f }); // Default white color
-        }
+        // Normals, texture coordinates and colors default when the derived class did not fill them in
+        glm::vec3 normal = i < normals.size() ? normals[i] : glm::vec3(0.0f);
+        glm::vec2 texCoord = i < texCoords.size() ? texCoords[i] : glm::vec2(0.0f);
+        glm::vec3 color = i < colors.size() ? colors[i] : glm::vec3(1.0f);     // Default white color
+        vertexData.push_back(packVertex(vertices[i], normal, texCoord, color));
+    }
+
+    boundsMin = vertices.empty() ? glm::vec3(0.0f) : vertices[0];
+    boundsMax = boundsMin;
+    for (const glm::vec3& vertex : vertices) {
+        boundsMin = glm::min(boundsMin, vertex);
+        boundsMax = glm::max(boundsMax, vertex);
     }
 
     setupBuffers(
         VAO, VBO, EBO,
-        vertexData.data(), vertexData.size() * sizeof(float),
+        vertexData.data(), vertexData.size() * sizeof(PackedVertex),
         indices.data(), indices.size() * sizeof(unsigned int),
-        { 3, 3, 2, 3 } // 3 for position, 3 for normal, 2 for texCoords, 3 for color
+        PACKED_VERTEX_LAYOUT
     );
 }
 
@@ -77,6 +79,22 @@ void MeshObject::render(ObjectShader& shader, Texture* texture) {
     GL_CHECK("MeshObject");
 }
 
+/**
+* Queue for drawing. Nothing is drawn until the queue is flushed.
+*/
+
+void MeshObject::submit(RenderQueue& queue, ObjectShader& shader, const Texture* texture) const {
+    DrawPacket packet;
+    packet.shader = &shader;
+    packet.texture = texture;
+    packet.vao = VAO;
+    packet.indexCount = GLsizei(indices.size());
+    packet.model = modelMatrix;
+    packet.tint = tint;
+    RenderQueue::transformBounds(modelMatrix, boundsMin, boundsMax, packet.boundsMin, packet.boundsMax);
+    queue.submit(packet);
+}
+
 
 // Getters and Setters
 void MeshObject::setModelMatrix(const glm::mat4& newModel) {
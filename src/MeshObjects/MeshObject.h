@@ -13,13 +13,20 @@
 #include "ObjectShader.h"
 #include "Texture.h"
 
+class RenderQueue;
+
 class MeshObject {
 public:
     MeshObject();
     virtual ~MeshObject() noexcept;
 
+    // GL objects are never shared: a copy starts without any and builds its own in updateMesh()
+    MeshObject(const MeshObject& other);
+    MeshObject& operator=(const MeshObject& other);
+
     virtual void updateMesh() = 0;
     virtual void render(ObjectShader& shader, Texture* texture = nullptr);
+    void submit(RenderQueue& queue, ObjectShader& shader, const Texture* texture = nullptr) const;
 
     // Getters and setters
     void setModelMatrix(const glm::mat4& newModel);
@@ -44,6 +51,7 @@ protected:
     // Only set on initialization; assumed static if the object does not move
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     glm::vec3 tint = glm::vec3(1.0f);
+    glm::vec3 boundsMin = glm::vec3(0.0f), boundsMax = glm::vec3(0.0f);    // Local, set with the buffers
 
     //glm::vec2 textureScale = glm::vec2(1.0f, 1.0f);
 
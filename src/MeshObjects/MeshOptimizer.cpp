@@ -0,0 +1,260 @@
+////////////////////////////////////////////////////////////////////////////////
+// MeshOptimizer.cpp -- Vertex welding and index reordering -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "MeshOptimizer.h"
+
+using namespace std;
+
+/**
+* Merge vertices whose attributes are bit-for-bit identical, and point the indices at the survivors.
+*
+* @param vertexData             [in/out] Interleaved vertices, compacted in place.
+* @param floatsPerVertex        [in] Floats per vertex.
+* @param indices                [in/out] Triangle list, remapped.
+*
+* @return Vertex count after welding.
+*/
+
+size_t weldVertices(vector<float>& vertexData, size_t floatsPerVertex, vector<uint32_t>& indices) {
+    size_t vertexCount = vertexData.size() / floatsPerVertex;
+    if (vertexCount == 0) return 0;
+
+    // Open addressing table of vertex ids, at most half full
+    size_t tableSize = 1;
+    while (tableSize < vertexCount * 2) tableSize <<= 1;
+    const uint32_t EMPTY = UINT32_MAX;
+    vector<uint32_t> table(tableSize, EMPTY);
+
+    const size_t vertexBytes = floatsPerVertex * sizeof(float);
+    vector<uint32_t> remap(vertexCount);
+    size_t uniqueCount = 0;
+
+    for (size_t v = 0; v < vertexCount; ++v) {
+        const float* vertex = &vertexData[v * floatsPerVertex];
+
+        // FNV-1a over the raw bits
+        uint32_t hash = 2166136261u;
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(vertex);
+        for (size_t b = 0; b < vertexBytes; ++b) {
+            hash ^= bytes[b];
+            hash *= 16777619u;
+        }
+
+        size_t slot = hash & (tableSize - 1);
+        while (table[slot] != EMPTY && memcmp(&vertexData[table[slot] * floatsPerVertex], vertex, vertexBytes) != 0) {
+            slot = (slot + 1) & (tableSize - 1);
+        }
+
+        if (table[slot] == EMPTY) {
+            // New vertex: move it down to the next free position. Its slot stores the new id.
+            if (uniqueCount != v) {
+                memmove(&vertexData[uniqueCount * floatsPerVertex], vertex, vertexBytes);
+            }
+            table[slot] = uint32_t(uniqueCount);
+            remap[v] = uint32_t(uniqueCount++);
+        }
+        else {
+            remap[v] = table[slot];
+        }
+    }
+
+    for (uint32_t& index : indices) index = remap[index];
+    vertexData.resize(uniqueCount * floatsPerVertex);
+    return uniqueCount;
+}
+
+/**
+* Reorder triangles so vertices are reused while still in the GPU's post-transform cache.
+*
+* This is Tom Forsyth's linear-speed vertex cache optimisation: a vertex scores higher the more recently it
+* was used and the fewer triangles it has left, and the highest scoring triangle touching the simulated cache
+* is emitted next.
+*
+* @param indices                [in/out] Triangle list, reordered.
+* @param vertexCount            [in] Number of vertices referenced.
+*/
+
+void optimizeVertexCache(vector<uint32_t>& indices, size_t vertexCount) {
+    const int CACHE_SIZE = 32;
+    const float CACHE_DECAY_POWER = 1.5f;
+    const float LAST_TRIANGLE_SCORE = 0.75f;
+    const float VALENCE_BOOST_SCALE = 2.0f;
+    const float VALENCE_BOOST_POWER = 0.5f;
+
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    auto vertexScore = [&](int cachePosition, uint32_t remaining) {
+        if (remaining == 0) return -1.0f;
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) score = LAST_TRIANGLE_SCORE;
+            else score = pow(1.0f - float(cachePosition - 3) / (CACHE_SIZE - 3), CACHE_DECAY_POWER);
+        }
+        return score + VALENCE_BOOST_SCALE * pow(float(remaining), -VALENCE_BOOST_POWER);
+    };
+
+    // Triangles touching each vertex, packed by vertex
+    vector<uint32_t> remaining(vertexCount, 0);
+    for (uint32_t index : indices) ++remaining[index];
+
+    vector<uint32_t> adjacencyStart(vertexCount + 1, 0);
+    for (size_t v = 0; v < vertexCount; ++v) adjacencyStart[v + 1] = adjacencyStart[v] + remaining[v];
+    vector<uint32_t> adjacency(indices.size());
+    vector<uint32_t> fill(adjacencyStart.begin(), adjacencyStart.end() - 1);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        for (int c = 0; c < 3; ++c) adjacency[fill[indices[t * 3 + c]]++] = uint32_t(t);
+    }
+
+    vector<int> cachePosition(vertexCount, -1);
+    vector<float> score(vertexCount);
+    for (size_t v = 0; v < vertexCount; ++v) score[v] = vertexScore(-1, remaining[v]);
+
+    vector<float> triangleScore(triangleCount);
+    vector<bool> emitted(triangleCount, false);
+    for (size_t t = 0; t < triangleCount; ++t) {
+        triangleScore[t] = score[indices[t * 3]] + score[indices[t * 3 + 1]] + score[indices[t * 3 + 2]];
+    }
+
+    vector<uint32_t> output;
+    output.reserve(indices.size());
+    vector<uint32_t> cache, nextCache;
+    cache.reserve(CACHE_SIZE + 3);
+    nextCache.reserve(CACHE_SIZE + 3);
+
+    size_t scanCursor = 0;
+    int64_t best = 0;
+    for (size_t t = 1; t < triangleCount; ++t) {
+        if (triangleScore[t] > triangleScore[best]) best = int64_t(t);
+    }
+
+    while (best >= 0) {
+        const uint32_t* triangle = &indices[size_t(best) * 3];
+        emitted[size_t(best)] = true;
+        output.insert(output.end(), triangle, triangle + 3);
+
+        // Take the triangle off its vertices' lists
+        for (int c = 0; c < 3; ++c) {
+            uint32_t v = triangle[c];
+            uint32_t* begin = &adjacency[adjacencyStart[v]];
+            uint32_t* end = begin + remaining[v];
+            *find(begin, end, uint32_t(best)) = *(end - 1);
+            --remaining[v];
+        }
+
+        // Most recent first, then the old cache minus the triangle's vertices
+        nextCache.assign(triangle, triangle + 3);
+        for (uint32_t v : cache) {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2]) nextCache.push_back(v);
+        }
+        for (size_t i = 0; i < nextCache.size(); ++i) {
+            uint32_t v = nextCache[i];
+            cachePosition[v] = i < size_t(CACHE_SIZE) ? int(i) : -1;
+            score[v] = vertexScore(cachePosition[v], remaining[v]);
+        }
+        if (nextCache.size() > size_t(CACHE_SIZE)) nextCache.resize(CACHE_SIZE);
+        swap(cache, nextCache);
+
+        // Only triangles around cached vertices changed score; the best of them goes next
+        best = -1;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t a = adjacencyStart[v]; a < adjacencyStart[v] + remaining[v]; ++a) {
+                uint32_t t = adjacency[a];
+                const uint32_t* tri = &indices[size_t(t) * 3];
+                triangleScore[t] = score[tri[0]] + score[tri[1]] + score[tri[2]];
+                if (triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = t;
+                }
+            }
+        }
+
+        // Nothing left near the cache: continue with the next unemitted triangle in input order
+        if (best < 0) {
+            while (scanCursor < triangleCount && emitted[scanCursor]) ++scanCursor;
+            if (scanCursor < triangleCount) best = int64_t(scanCursor);
+        }
+    }
+
+    indices.swap(output);
+}
+
+/**
+* Renumber vertices in the order the index buffer first uses them, so vertex fetches walk memory forwards.
+* Vertices no triangle uses are dropped.
+*
+* @param vertexData             [in/out] Interleaved vertices, reordered.
+* @param floatsPerVertex        [in] Floats per vertex.
+* @param indices                [in/out] Triangle list, remapped.
+*/
+
+void optimizeVertexFetch(vector<float>& vertexData, size_t floatsPerVertex, vector<uint32_t>& indices) {
+    size_t vertexCount = vertexData.size() / floatsPerVertex;
+    const uint32_t UNUSED = UINT32_MAX;
+    vector<uint32_t> remap(vertexCount, UNUSED);
+    vector<float> reordered;
+    reordered.reserve(vertexData.size());
+
+    uint32_t next = 0;
+    for (uint32_t& index : indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = next++;
+            reordered.insert(reordered.end(), vertexData.begin() + index * floatsPerVertex, vertexData.begin() + (index + 1) * floatsPerVertex);
+        }
+        index = remap[index];
+    }
+    vertexData.swap(reordered);
+}
+
+/**
+* Vertex shader invocations per triangle for a FIFO post-transform cache.
+*
+* @param indices                [in] Triangle list.
+* @param vertexCount            [in] Number of vertices referenced.
+* @param cacheSize              [in] Cache entries to simulate.
+*/
+
+float computeACMR(const vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize) {
+    if (indices.size() < 3) return 0.0f;
+
+    // A vertex is cached while fewer than cacheSize misses have happened since it was loaded
+    vector<size_t> loadedAt(vertexCount, SIZE_MAX);
+    size_t misses = 0;
+    for (uint32_t index : indices) {
+        if (loadedAt[index] == SIZE_MAX || misses - loadedAt[index] >= cacheSize) {
+            loadedAt[index] = misses++;
+        }
+    }
+    return float(misses) / float(indices.size() / 3);
+}
+
+/**
+* Weld, then order triangles for the post-transform cache and vertices for fetch locality.
+*
+* @param vertexData             [in/out] Interleaved vertices.
+* @param floatsPerVertex        [in] Floats per vertex.
+* @param indices                [in/out] Triangle list.
+*
+* @return Vertex counts and ACMR before and after.
+*/
+
+MeshOptimizeStats optimizeMesh(vector<float>& vertexData, size_t floatsPerVertex, vector<uint32_t>& indices) {
+    MeshOptimizeStats stats;
+    stats.vertexCountBefore = vertexData.size() / floatsPerVertex;
+    stats.acmrBefore = computeACMR(indices, stats.vertexCountBefore);
+
+    stats.vertexCountAfter = weldVertices(vertexData, floatsPerVertex, indices);
+    optimizeVertexCache(indices, stats.vertexCountAfter);
+    optimizeVertexFetch(vertexData, floatsPerVertex, indices);
+
+    stats.vertexCountAfter = vertexData.size() / floatsPerVertex;
+    stats.acmrAfter = computeACMR(indices, stats.vertexCountAfter);
+    return stats;
+}
@@ -0,0 +1,28 @@
+////////////////////////////////////////////////////////////////////////////////
+// MeshOptimizer.h -- Vertex welding and index reordering include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+* Result of optimizeMesh(). ACMR (average cache miss ratio) is vertex shader runs per triangle for a FIFO
+* post-transform cache: 3.0 means no reuse at all, about 0.6-0.7 is typical of a well ordered closed mesh.
+*/
+struct MeshOptimizeStats {
+    size_t vertexCountBefore = 0;
+    size_t vertexCountAfter = 0;
+    float acmrBefore = 0.0f;
+    float acmrAfter = 0.0f;
+};
+
+size_t weldVertices(std::vector<float>& vertexData, size_t floatsPerVertex, std::vector<uint32_t>& indices);
+void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+void optimizeVertexFetch(std::vector<float>& vertexData, size_t floatsPerVertex, std::vector<uint32_t>& indices);
+float computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, size_t cacheSize = 16);
+
+MeshOptimizeStats optimizeMesh(std::vector<float>& vertexData, size_t floatsPerVertex, std::vector<uint32_t>& indices);
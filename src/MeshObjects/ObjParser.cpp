@@ -0,0 +1,556 @@
+////////////////////////////////////////////////////////////////////////////////
+// ObjParser.cpp -- Parallel Wavefront OBJ parser -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <set>
+#include <thread>
+
+#include "ObjParser.h"
+
+#include "MappedFile.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr unsigned char RELATIVE_POSITION = 1;
+constexpr unsigned char RELATIVE_TEXCOORD = 2;
+constexpr unsigned char RELATIVE_NORMAL = 4;
+
+// A face corner as read from a chunk. Relative indices count from the chunk's first element and are flagged, so
+// the merge can add the number of elements in the chunks before it. -1 is a missing texture coordinate or normal.
+struct ObjCorner {
+    int position = -1;
+    int texCoord = -1;
+    int normal = -1;
+    unsigned char relative = 0;         // RELATIVE_ bits
+};
+
+struct ObjChunk {
+    const char* begin = nullptr;
+    const char* end = nullptr;
+
+    // Filled by parseChunk()
+    vector<float> positions;            // 3 per vertex
+    vector<float> texCoords;            // 2 per vertex
+    vector<float> normals;              // 3 per vertex
+    vector<ObjCorner> corners;          // Every face's corners, in order
+    vector<int> faceSizes;              // Corners per face
+    vector<int> faceMaterials;          // Index into materialNames, -1 before the chunk's first usemtl
+    vector<string> materialNames;       // Every usemtl, in order
+    vector<pair<size_t, string>> shapeStarts;   // First face (first triangle after triangulateChunk()) and name of every o or g
+    vector<string> mtlLibs;
+    int badLines = 0;
+
+    // Filled by triangulateChunk()
+    vector<tinyobj::index_t> triangles;         // 3 per triangle, indices into the merged arrays
+    vector<int> triangleMaterials;              // As faceMaterials
+    bool missingVertex = false;
+
+    vector<ObjCorner> polygon;          // Scratch for the face being read
+};
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p < end && (*p == ' ' || *p == '\t')) ++p;
+    return p;
+}
+
+bool isEndOfStatement(const char* p, const char* end) {
+    return p == end || *p == '\r' || *p == '#';
+}
+
+// Keyword followed by a space or tab
+bool startsWith(const char* p, const char* end, const char* keyword) {
+    size_t length = strlen(keyword);
+    return size_t(end - p) > length && memcmp(p, keyword, length) == 0 && (p[length] == ' ' || p[length] == '\t');
+}
+
+bool parseFloat(const char*& p, const char* end, float& value) {
+    p = skipSpaces(p, end);
+    if (p < end && *p == '+') ++p;      // from_chars does not take a plus sign
+    from_chars_result result = from_chars(p, end, value);
+    if (result.ec != errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+bool parseInt(const char*& p, const char* end, int& value) {
+    if (p < end && *p == '+') ++p;
+    from_chars_result result = from_chars(p, end, value);
+    if (result.ec != errc()) return false;
+    p = result.ptr;
+    return true;
+}
+
+bool parseIndex(const char*& p, const char* end, int count, unsigned char relativeBit, int& index, unsigned char& relative) {
+    int value;
+    if (!parseInt(p, end, value) || value == 0) return false;
+    if (value > 0) {
+        index = value - 1;
+    }
+    else {
+        index = count + value;
+        relative |= relativeBit;
+    }
+    return true;
+}
+
+// v, v/vt, v//vn or v/vt/vn
+bool parseCorner(const char*& p, const char* end, const ObjChunk& chunk, ObjCorner& corner) {
+    if (!parseIndex(p, end, int(chunk.positions.size() / 3), RELATIVE_POSITION, corner.position, corner.relative)) return false;
+    if (p == end || *p != '/') return true;
+
+    ++p;
+    if (p < end && *p != '/') {
+        if (!parseIndex(p, end, int(chunk.texCoords.size() / 2), RELATIVE_TEXCOORD, corner.texCoord, corner.relative)) return false;
+    }
+    if (p == end || *p != '/') return true;
+
+    ++p;
+    return parseIndex(p, end, int(chunk.normals.size() / 3), RELATIVE_NORMAL, corner.normal, corner.relative);
+}
+
+string parseName(const char* p, const char* end) {
+    p = skipSpaces(p, end);
+    while (end > p && (end[-1] == ' ' || end[-1] == '\t' || end[-1] == '\r')) --end;
+    return string(p, end);
+}
+
+void parseLine(ObjChunk& chunk, const char* p, const char* end) {
+    p = skipSpaces(p, end);
+    if (isEndOfStatement(p, end)) return;
+
+    if (startsWith(p, end, "v")) {
+        float x, y, z;
+        p += 1;
+        if (!parseFloat(p, end, x) || !parseFloat(p, end, y) || !parseFloat(p, end, z)) ++chunk.badLines;
+        else chunk.positions.insert(chunk.positions.end(), { x, y, z });     // Optional w or vertex color ignored
+    }
+    else if (startsWith(p, end, "vt")) {
+        float u, v = 0.0f;
+        p += 2;
+        if (!parseFloat(p, end, u)) ++chunk.badLines;
+        else {
+            parseFloat(p, end, v);
+            chunk.texCoords.insert(chunk.texCoords.end(), { u, v });
+        }
+    }
+    else if (startsWith(p, end, "vn")) {
+        float x, y, z;
+        p += 2;
+        if (!parseFloat(p, end, x) || !parseFloat(p, end, y) || !parseFloat(p, end, z)) ++chunk.badLines;
+        else chunk.normals.insert(chunk.normals.end(), { x, y, z });
+    }
+    else if (startsWith(p, end, "f")) {
+        p += 1;
+        chunk.polygon.clear();
+        while (true) {
+            p = skipSpaces(p, end);
+            if (isEndOfStatement(p, end)) break;
+            ObjCorner corner;
+            if (!parseCorner(p, end, chunk, corner)) {
+                chunk.polygon.clear();
+                break;
+            }
+            chunk.polygon.push_back(corner);
+        }
+        if (chunk.polygon.size() < 3) {
+            ++chunk.badLines;
+            return;
+        }
+
+        // Triangulated once every position is known, see triangulateChunk()
+        chunk.corners.insert(chunk.corners.end(), chunk.polygon.begin(), chunk.polygon.end());
+        chunk.faceSizes.push_back(int(chunk.polygon.size()));
+        chunk.faceMaterials.push_back(chunk.materialNames.empty() ? -1 : int(chunk.materialNames.size()) - 1);
+    }
+    else if (startsWith(p, end, "o") || startsWith(p, end, "g")) {
+        chunk.shapeStarts.emplace_back(chunk.faceSizes.size(), parseName(p + 1, end));
+    }
+    else if (startsWith(p, end, "usemtl")) {
+        chunk.materialNames.push_back(parseName(p + 6, end));
+    }
+    else if (startsWith(p, end, "mtllib")) {
+        string names = parseName(p + 6, end);
+        size_t start = 0;
+        while (start < names.size()) {
+            size_t stop = names.find_first_of(" \t", start);
+            if (stop == string::npos) stop = names.size();
+            if (stop > start) chunk.mtlLibs.push_back(names.substr(start, stop - start));
+            start = stop + 1;
+        }
+    }
+}
+
+void parseChunk(ObjChunk& chunk) {
+    const char* p = chunk.begin;
+    while (p < chunk.end) {
+        const char* lineEnd = static_cast<const char*>(memchr(p, '\n', chunk.end - p));
+        if (lineEnd == nullptr) lineEnd = chunk.end;
+        parseLine(chunk, p, lineEnd);
+        p = lineEnd + 1;
+    }
+    vector<ObjCorner>().swap(chunk.polygon);
+}
+
+// Index into the merged arrays, or -1 if missing
+int resolveIndex(int index, bool relative, size_t base) {
+    if (index < 0 && !relative) return -1;
+    return relative ? int(base) + index : index;
+}
+
+// Point in triangle test of the ear clipper, as in tinyobj
+int pnpoly(int nvert, const float* vertx, const float* verty, float testx, float testy) {
+    int i, j, c = 0;
+    for (i = 0, j = nvert - 1; i < nvert; j = i++) {
+        if (((verty[i] > testy) != (verty[j] > testy))
+            && (testx < (vertx[j] - vertx[i]) * (testy - verty[i]) / (verty[j] - verty[i]) + vertx[i])) {
+            c = !c;
+        }
+    }
+    return c;
+}
+
+/**
+* Split a polygon into triangles the way tinyobj::LoadObj(triangulate = true) does, so both parsers give the same
+* mesh: a quad is cut along its shorter diagonal, and larger polygons are ear clipped in the axis plane picked from
+* their first non-degenerate corner. Like tinyobj, an ear clip that stops finding ears drops the rest of the polygon.
+*
+* @param polygon                [in] Corners, indices already resolved and checked against positions.
+* @param positions              [in] Merged positions, 3 per vertex.
+* @param out                    [in/out] Triangles are appended here, 3 corners each.
+*
+* @return Triangles added.
+*/
+
+int triangulate(vector<tinyobj::index_t>& polygon, const vector<float>& positions, vector<tinyobj::index_t>& out) {
+    auto position = [&](const tinyobj::index_t& index) { return &positions[3 * size_t(index.vertex_index)]; };
+    size_t corners = polygon.size();
+
+    if (corners == 3) {
+        out.insert(out.end(), polygon.begin(), polygon.end());
+        return 1;
+    }
+
+    if (corners == 4) {
+        const float* v0 = position(polygon[0]);
+        const float* v1 = position(polygon[1]);
+        const float* v2 = position(polygon[2]);
+        const float* v3 = position(polygon[3]);
+        float e02x = v2[0] - v0[0], e02y = v2[1] - v0[1], e02z = v2[2] - v0[2];
+        float e13x = v3[0] - v1[0], e13y = v3[1] - v1[1], e13z = v3[2] - v1[2];
+        float sqr02 = e02x * e02x + e02y * e02y + e02z * e02z;
+        float sqr13 = e13x * e13x + e13y * e13y + e13z * e13z;
+        if (sqr02 < sqr13) out.insert(out.end(), { polygon[0], polygon[1], polygon[2], polygon[0], polygon[2], polygon[3] });
+        else out.insert(out.end(), { polygon[0], polygon[1], polygon[3], polygon[1], polygon[2], polygon[3] });
+        return 2;
+    }
+
+    // Project onto the axis plane the polygon faces most, judged by the first corner that is not a straight line
+    size_t axes[2] = { 1, 2 };
+    const float epsilon = numeric_limits<float>::epsilon();
+    for (size_t k = 0; k < corners; ++k) {
+        const float* v0 = position(polygon[k]);
+        const float* v1 = position(polygon[(k + 1) % corners]);
+        const float* v2 = position(polygon[(k + 2) % corners]);
+        float e0x = v1[0] - v0[0], e0y = v1[1] - v0[1], e0z = v1[2] - v0[2];
+        float e1x = v2[0] - v1[0], e1y = v2[1] - v1[1], e1z = v2[2] - v1[2];
+        float cx = fabs(e0y * e1z - e0z * e1y);
+        float cy = fabs(e0z * e1x - e0x * e1z);
+        float cz = fabs(e0x * e1y - e0y * e1x);
+        if (cx > epsilon || cy > epsilon || cz > epsilon) {
+            if (!(cx > cy && cx > cz)) {
+                axes[0] = 0;
+                if (cz > cx && cz > cy) axes[1] = 1;
+            }
+            break;
+        }
+    }
+
+    int added = 0;
+    size_t guess = 0;
+    size_t remainingIterations = corners;       // Tries left without removing a corner
+    size_t previousCorners = corners;
+    while (polygon.size() > 3 && remainingIterations > 0) {
+        size_t count = polygon.size();
+        if (guess >= count) guess -= count;
+        if (previousCorners != count) {
+            previousCorners = count;
+            remainingIterations = count;
+        }
+        else {
+            --remainingIterations;
+        }
+
+        tinyobj::index_t ear[3];
+        float vx[3], vy[3];
+        for (size_t k = 0; k < 3; ++k) {
+            ear[k] = polygon[(guess + k) % count];
+            vx[k] = position(ear[k])[axes[0]];
+            vy[k] = position(ear[k])[axes[1]];
+        }
+
+        // Reflex corner
+        float e0x = vx[1] - vx[0], e0y = vy[1] - vy[0];
+        float e1x = vx[2] - vx[1], e1y = vy[2] - vy[1];
+        float cross = e0x * e1y - e0y * e1x;
+        float area = (vx[0] * vy[1] - vy[0] * vx[1]) * 0.5f;
+        if (cross * area < 0.0f) {
+            ++guess;
+            continue;
+        }
+
+        // Another corner inside the candidate ear
+        bool overlap = false;
+        for (size_t other = 3; other < count && !overlap; ++other) {
+            const float* v = position(polygon[(guess + other) % count]);
+            overlap = pnpoly(3, vx, vy, v[axes[0]], v[axes[1]]) != 0;
+        }
+        if (overlap) {
+            ++guess;
+            continue;
+        }
+
+        out.insert(out.end(), ear, ear + 3);
+        ++added;
+        polygon.erase(polygon.begin() + (guess + 1) % count);
+    }
+
+    if (polygon.size() == 3) {
+        out.insert(out.end(), polygon.begin(), polygon.end());
+        ++added;
+    }
+    return added;
+}
+
+/**
+* Resolve a parsed chunk's indices and triangulate its faces. Needs every chunk's positions merged already.
+*
+* @param chunk                  [in/out] Parsed chunk; its faces are replaced by triangles.
+* @param positions              [in] Merged positions.
+* @param positionBase           [in] Positions in the chunks before this one, likewise for the others.
+* @param positionCount          [in] Positions in the whole file, likewise for the others.
+*/
+
+void triangulateChunk(ObjChunk& chunk, const vector<float>& positions, size_t positionBase, size_t texCoordBase,
+    size_t normalBase, size_t positionCount, size_t texCoordCount, size_t normalCount) {
+    vector<tinyobj::index_t> polygon;
+    size_t nextShape = 0;
+    size_t corner = 0;
+    chunk.triangles.reserve(chunk.corners.size() * 3);
+
+    for (size_t face = 0; face < chunk.faceSizes.size(); ++face) {
+        while (nextShape < chunk.shapeStarts.size() && chunk.shapeStarts[nextShape].first == face) {
+            chunk.shapeStarts[nextShape++].first = chunk.triangleMaterials.size();
+        }
+
+        polygon.clear();
+        for (int k = 0; k < chunk.faceSizes[face]; ++k) {
+            const ObjCorner& c = chunk.corners[corner++];
+            tinyobj::index_t index;
+            index.vertex_index = resolveIndex(c.position, c.relative & RELATIVE_POSITION, positionBase);
+            index.texcoord_index = resolveIndex(c.texCoord, c.relative & RELATIVE_TEXCOORD, texCoordBase);
+            index.normal_index = resolveIndex(c.normal, c.relative & RELATIVE_NORMAL, normalBase);
+            if (index.vertex_index < 0 || size_t(index.vertex_index) >= positionCount
+                || size_t(index.texcoord_index + 1) > texCoordCount || size_t(index.normal_index + 1) > normalCount) {
+                chunk.missingVertex = true;
+                return;
+            }
+            polygon.push_back(index);
+        }
+
+        int added = triangulate(polygon, positions, chunk.triangles);
+        chunk.triangleMaterials.insert(chunk.triangleMaterials.end(), added, chunk.faceMaterials[face]);
+    }
+    for (; nextShape < chunk.shapeStarts.size(); ++nextShape) {
+        chunk.shapeStarts[nextShape].first = chunk.triangleMaterials.size();
+    }
+
+    vector<ObjCorner>().swap(chunk.corners);
+    vector<int>().swap(chunk.faceSizes);
+    vector<int>().swap(chunk.faceMaterials);
+}
+
+/**
+* Run work on every chunk, on up to one thread per core including this one.
+*
+* @param count                  [in] Chunks.
+* @param work                   [in] Called with each chunk index, from any of the threads.
+* @param onChunk                [in] Called on this thread with the number of chunks done, after each chunk it ran.
+*/
+
+void forEachChunk(size_t count, const function<void(size_t)>& work, const function<void(size_t)>& onChunk) {
+    atomic<size_t> nextChunk{ 0 };
+    atomic<size_t> doneChunks{ 0 };
+    auto runNext = [&]() {
+        size_t index = nextChunk++;
+        if (index >= count) return false;
+        work(index);
+        ++doneChunks;
+        return true;
+    };
+
+    size_t threadCount = std::min<size_t>(std::max(thread::hardware_concurrency(), 1u), count);
+    vector<thread> workers;
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back([&]() { while (runNext()) {} });
+    }
+    while (runNext()) onChunk(doneChunks);
+    for (thread& worker : workers) worker.join();
+}
+
+}  // namespace
+
+/**
+* Parse an OBJ file and the MTL files it names.
+*
+* @param path                   [in] Path to the .obj file.
+* @param attrib                 [out] Positions, normals and texture coordinates.
+* @param shapes                 [out] One per o or g statement that has faces; faces are triangles.
+* @param materials              [out] From the MTL files.
+* @param warn                   [out] Skipped lines and missing MTL files.
+* @param err                    [out] Why loading failed.
+* @param onProgress             [in] Optional, called on this thread with the fraction done.
+*
+* @return false if the file cannot be read or a face refers to a missing vertex.
+*/
+
+bool ObjParser::load(const string& path, tinyobj::attrib_t& attrib, vector<tinyobj::shape_t>& shapes,
+    vector<tinyobj::material_t>& materials, string& warn, string& err, const function<void(float)>& onProgress) {
+    attrib = tinyobj::attrib_t();
+    shapes.clear();
+    materials.clear();
+
+    MappedFile file;
+    if (!file.open(path)) {
+        err += "Cannot open file [" + path + "]\n";
+        return false;
+    }
+
+    // Cut into chunks that end on line breaks
+    const char* data = reinterpret_cast<const char*>(file.getData());
+    const char* dataEnd = data + file.getSize();
+    vector<ObjChunk> chunks;
+    for (const char* p = data; p < dataEnd; ) {
+        const char* chunkEnd = (size_t(dataEnd - p) > CHUNK_SIZE) ? p + CHUNK_SIZE : dataEnd;
+        chunkEnd = find(chunkEnd, dataEnd, '\n');
+        if (chunkEnd != dataEnd) ++chunkEnd;
+        chunks.emplace_back();
+        chunks.back().begin = p;
+        chunks.back().end = chunkEnd;
+        p = chunkEnd;
+    }
+
+    // Parsing is most of the work, triangulation and the merge the rest
+    auto report = [&](float start, float share, size_t done) {
+        if (onProgress) onProgress(start + share * float(done) / float(std::max<size_t>(chunks.size(), 1)));
+    };
+    forEachChunk(chunks.size(), [&](size_t index) { parseChunk(chunks[index]); },
+        [&](size_t done) { report(0.0f, 0.8f, done); });
+
+    // Materials, each MTL file once, in the order they are named
+    map<string, int> materialMap;
+    set<string> loadedMtls;
+    for (const ObjChunk& chunk : chunks) {
+        for (const string& name : chunk.mtlLibs) {
+            if (!loadedMtls.insert(name).second) continue;
+            string mtlPath = (fs::path(path).parent_path() / name).string();
+            ifstream mtl(mtlPath);
+            if (!mtl) {
+                warn += "Material file [" + mtlPath + "] not found\n";
+                continue;
+            }
+            tinyobj::LoadMtl(&materialMap, &materials, &mtl, &warn, &err);
+        }
+    }
+
+    // Vertex data in file order. Triangulation needs all of it, since a face may use any earlier position.
+    size_t positionCount = 0, texCoordCount = 0, normalCount = 0;
+    int badLines = 0;
+    vector<size_t> positionBases, texCoordBases, normalBases;
+    for (const ObjChunk& chunk : chunks) {
+        positionBases.push_back(positionCount);
+        texCoordBases.push_back(texCoordCount);
+        normalBases.push_back(normalCount);
+        positionCount += chunk.positions.size() / 3;
+        texCoordCount += chunk.texCoords.size() / 2;
+        normalCount += chunk.normals.size() / 3;
+        badLines += chunk.badLines;
+    }
+    if (badLines > 0) warn += "Skipped " + to_string(badLines) + " malformed lines in [" + path + "]\n";
+    attrib.vertices.reserve(positionCount * 3);
+    attrib.texcoords.reserve(texCoordCount * 2);
+    attrib.normals.reserve(normalCount * 3);
+    for (ObjChunk& chunk : chunks) {
+        attrib.vertices.insert(attrib.vertices.end(), chunk.positions.begin(), chunk.positions.end());
+        attrib.texcoords.insert(attrib.texcoords.end(), chunk.texCoords.begin(), chunk.texCoords.end());
+        attrib.normals.insert(attrib.normals.end(), chunk.normals.begin(), chunk.normals.end());
+        vector<float>().swap(chunk.positions);      // Release as we go, the file may be huge
+        vector<float>().swap(chunk.texCoords);
+        vector<float>().swap(chunk.normals);
+    }
+
+    forEachChunk(chunks.size(), [&](size_t index) {
+        triangulateChunk(chunks[index], attrib.vertices, positionBases[index], texCoordBases[index], normalBases[index],
+            positionCount, texCoordCount, normalCount);
+    }, [&](size_t done) { report(0.8f, 0.1f, done); });
+
+    for (const ObjChunk& chunk : chunks) {
+        if (chunk.missingVertex) {
+            err += "Face refers to a missing vertex in [" + path + "]\n";
+            return false;
+        }
+    }
+
+    // Merge in file order. Materials and shapes carry over from one chunk into the next.
+    tinyobj::shape_t shape;
+    auto finishShape = [&]() {
+        if (!shape.mesh.indices.empty()) shapes.push_back(std::move(shape));
+        shape = tinyobj::shape_t();
+    };
+    int material = -1;
+
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        ObjChunk& chunk = chunks[c];
+        vector<int> chunkMaterials;
+        for (const string& name : chunk.materialNames) {
+            auto it = materialMap.find(name);
+            chunkMaterials.push_back(it != materialMap.end() ? it->second : -1);
+        }
+
+        size_t nextShape = 0;
+        size_t triangleCount = chunk.triangleMaterials.size();
+        for (size_t triangle = 0; triangle <= triangleCount; ++triangle) {
+            while (nextShape < chunk.shapeStarts.size() && chunk.shapeStarts[nextShape].first == triangle) {
+                finishShape();
+                shape.name = chunk.shapeStarts[nextShape++].second;
+            }
+            if (triangle == triangleCount) break;
+
+            if (chunk.triangleMaterials[triangle] >= 0) material = chunkMaterials[chunk.triangleMaterials[triangle]];
+            shape.mesh.indices.insert(shape.mesh.indices.end(), &chunk.triangles[3 * triangle], &chunk.triangles[3 * triangle] + 3);
+            shape.mesh.num_face_vertices.push_back(3);
+            shape.mesh.material_ids.push_back(material);
+            shape.mesh.smoothing_group_ids.push_back(0);
+        }
+        // A usemtl after the chunk's last face still applies to the next chunk's leading faces
+        if (!chunkMaterials.empty()) material = chunkMaterials.back();
+
+        chunk = ObjChunk();
+        report(0.9f, 0.1f, c + 1);
+    }
+    finishShape();
+
+    return true;
+}
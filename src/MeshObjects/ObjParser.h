@@ -0,0 +1,33 @@
+////////////////////////////////////////////////////////////////////////////////
+// ObjParser.h -- Parallel Wavefront OBJ parser include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "tiny_obj_loader.h"
+
+/**
+* Reads an OBJ into the same structures as tinyobj::LoadObj (triangulated), for models too big to parse on one
+* thread. The file is memory mapped and cut into CHUNK_SIZE pieces ending on line breaks, each chunk is parsed on
+* its own thread with std::from_chars, and the chunks are merged in file order, so the result does not depend on
+* thread timing. Relative (negative) indices, materials and shapes that span chunk boundaries are resolved during
+* the merge. MTL files are read with tinyobj.
+*
+* Polygons are split with tinyobj's rules (shorter diagonal for quads, ear clipping beyond), in parallel once all
+* positions are merged, so the triangles match tinyobj's exactly.
+*
+* Supported: v, vt, vn, f (any polygon), o, g, usemtl, mtllib. Other statements are ignored.
+*/
+class ObjParser {
+public:
+    static constexpr size_t CHUNK_SIZE = 4 * 1024 * 1024;
+
+    static bool load(const std::string& path, tinyobj::attrib_t& attrib, std::vector<tinyobj::shape_t>& shapes,
+        std::vector<tinyobj::material_t>& materials, std::string& warn, std::string& err,
+        const std::function<void(float)>& onProgress = nullptr);
+};
@@ -27,6 +27,7 @@ bool MessageLog::isOpen() const {
 }
 
 void MessageLog::addMessage(const string& text, MessageType type, bool overwrite) {
+    lock_guard<std::mutex> lock(mutex);
     messageLog.emplace_back(text, type);
     // Only show the log on warnings or higher
     if (overwrite || type >= MessageType::WARNING) {
@@ -37,6 +38,7 @@ void MessageLog::addMessage(const string& text, MessageType type, bool overwrite
 // Displays the message log on screen with all the messages
 void MessageLog::render() {
     if (!visible) return;   
+    lock_guard<std::mutex> lock(mutex);
     SetWindowPositionAndSize(2, 4, 1, 4);
     ImGui::Begin("Message Log", nullptr, ImGuiWindowFlags_None);
 
@@ -68,6 +70,7 @@ void MessageLog::save(const string& path) {
     localtime_r(&now, &timeInfo);
 #endif
 
+    lock_guard<std::mutex> lock(mutex);
     for (const auto& message : messageLog) {
         std::cout << "[" << message.getTypeString() << "] " << message.text << std::endl;
     }
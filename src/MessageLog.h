@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include <string>
 
@@ -9,6 +11,7 @@
 * Singleton
 * 
 * Provides a log for easier user-facing and debugging messages.
+* addMessage() is safe to call from the physics thread.
 */
 class MessageLog {
 public:
@@ -31,6 +34,7 @@ private:
     MessageLog() : visible(false) {}
     ~MessageLog() = default;
 
-    bool visible;
+    std::atomic<bool> visible;
+    std::mutex mutex;       // Guards messageLog
     std::vector<GameMessage> messageLog;
 };
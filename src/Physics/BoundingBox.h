@@ -8,7 +8,7 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
-class ObjectShader;
+class DebugRenderer;
 
 // Currently unused.
 class BoundingBox {
@@ -16,15 +16,12 @@ public:
     glm::vec3 min;
     glm::vec3 max;
 
-    unsigned int VAO{}, VBO{}, EBO{};
-
     BoundingBox();
     BoundingBox(const glm::vec3& min, const glm::vec3& max);
-    ~BoundingBox();
 
     // These ones are actually used
     static bool intersect(const BoundingBox& a, const BoundingBox& b);
-    void renderDebug(ObjectShader& shader, const glm::vec3& bodyPosition);
+    void renderDebug(DebugRenderer& debugRenderer, const glm::vec3& bodyPosition) const;
 
     // Naive implementaiton that clamps limits
     glm::vec3 closestPointOutside(const glm::vec3& point) const;
@@ -36,6 +33,4 @@ public:
     void update(const glm::vec3& position, const glm::quat& orientation);
     void expandToInclude(const BoundingBox& other);
     void expandToInclude(const glm::vec3& point);
-private:
-    void setupBoundingBoxBuffers();
 };
\ No newline at end of file
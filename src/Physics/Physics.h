@@ -5,11 +5,13 @@
 
 #pragma once
 
+#include <random>
+
 #include "Units.h"
 using namespace Units;
 
 class BeybladeBody;
-class Stadium;
+class StadiumBody;
 
 class Physics {
 public:
@@ -31,12 +33,12 @@ public:
     }
 
     void accumulateAirResistance(BeybladeBody* beyblade) const;
-    void accumulateFriction(BeybladeBody* beyblade, Stadium* stadium) const;
-    void accumulateSlope(BeybladeBody* beyblade, Stadium* stadium) const;
+    void accumulateFriction(BeybladeBody* beyblade, const StadiumBody* stadium) const;
+    void accumulateSlope(BeybladeBody* beyblade, const StadiumBody* stadium) const;
 
     // Important: These are not const, as they immediately change position due to contact
     void accumulateImpact(BeybladeBody* beyblade1, BeybladeBody* beyblade2, M contactDistance);
-    void preventStadiumClipping(BeybladeBody* beybladeBody, Stadium* stadium);
+    void preventStadiumClipping(BeybladeBody* beybladeBody, const StadiumBody* stadium);
 
 
     M_S2 GRAVITY = 9.81_m_s2;
@@ -51,6 +53,10 @@ public:
     Scalar FRICTIONAL_VELOCITY_CONSTANT;        // Impact of angular speed on frictional force with the stadium.
 
     Kg_M3 FLUID_DRAG;                           // (TODO: replace with airDensity)
+
+    // Headless simulations turn these off / set a seeded generator so runs are quiet and reproducible
+    bool logImpacts = true;                     // Print collision details to the console
+    std::mt19937* recoilGenerator = nullptr;    // If null, recoil uses the shared generator in RandomDistribution
 };
 
 
@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// PhysicsProfiler.cpp -- Per-phase physics timing -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <vector>
+
+#include "PhysicsProfiler.h"
+
+using namespace std;
+
+/**
+* Finish the tick: charge the whole tick to TOTAL and add it to the history.
+*/
+
+void PhysicsProfiler::endTick() {
+    current.nanoseconds[int(PhysicsPhase::TOTAL)] = chrono::duration_cast<chrono::nanoseconds>(Clock::now() - tickStart).count();
+
+    lock_guard<mutex> lock(historyMutex);
+    history[historyNext] = current;
+    historyNext = (historyNext + 1) % HISTORY_SIZE;
+    historyCount = min(historyCount + 1, HISTORY_SIZE);
+}
+
+/**
+* Time spent in a phase per tick over the recorded history, in milliseconds.
+*
+* @param phase                  [in] Phase to report.
+*/
+
+PhysicsStat PhysicsProfiler::getStat(PhysicsPhase phase) const {
+    return computeStat([phase](const TickSample& sample) { return sample.nanoseconds[int(phase)] * 1e-6; });
+}
+
+/**
+* Count per tick over the recorded history.
+*
+* @param counter                [in] Counter to report.
+*/
+
+PhysicsStat PhysicsProfiler::getStat(PhysicsCounter counter) const {
+    return computeStat([counter](const TickSample& sample) { return double(sample.counts[int(counter)]); });
+}
+
+size_t PhysicsProfiler::getTickCount() const {
+    lock_guard<mutex> lock(historyMutex);
+    return historyCount;
+}
+
+void PhysicsProfiler::reset() {
+    lock_guard<mutex> lock(historyMutex);
+    historyCount = 0;
+    historyNext = 0;
+}
+
+const char* PhysicsProfiler::getName(PhysicsPhase phase) {
+    switch (phase) {
+    case PhysicsPhase::STADIUM_CONTACT: return "Stadium contact";
+    case PhysicsPhase::PAIR_TESTS:      return "Pair tests";
+    case PhysicsPhase::IMPACTS:         return "Impacts";
+    case PhysicsPhase::INTEGRATION:     return "Integration";
+    case PhysicsPhase::CLIPPING:        return "Clipping";
+    case PhysicsPhase::TOTAL:           return "Total";
+    default:                            return "?";
+    }
+}
+
+const char* PhysicsProfiler::getName(PhysicsCounter counter) {
+    switch (counter) {
+    case PhysicsCounter::STADIUM_CONTACTS:  return "Stadium contacts";
+    case PhysicsCounter::PAIR_TESTS:        return "Pair tests";
+    case PhysicsCounter::CONTACTS:          return "Contacts";
+    case PhysicsCounter::IMPACTS:           return "Impacts";
+    default:                                return "?";
+    }
+}
+
+template <typename Getter>
+PhysicsStat PhysicsProfiler::computeStat(Getter getter) const {
+    vector<double> values;
+    {
+        lock_guard<mutex> lock(historyMutex);
+        values.reserve(historyCount);
+        for (size_t i = 0; i < historyCount; ++i) values.push_back(getter(history[i]));
+    }
+
+    PhysicsStat stat;
+    if (values.empty()) return stat;
+
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+        stat.max = max(stat.max, value);
+    }
+    stat.average = sum / values.size();
+
+    size_t p99Index = min(values.size() - 1, values.size() * 99 / 100);
+    nth_element(values.begin(), values.begin() + p99Index, values.end());
+    stat.p99 = values[p99Index];
+    return stat;
+}
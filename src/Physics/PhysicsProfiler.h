@@ -0,0 +1,116 @@
+////////////////////////////////////////////////////////////////////////////////
+// PhysicsProfiler.h -- Per-phase physics timing include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+enum class PhysicsPhase : int {
+    STADIUM_CONTACT = 0,    // Spin and bounds checks, air resistance, gravity, friction and slope
+    PAIR_TESTS,             // Bey-bey overlap tests
+    IMPACTS,                // Collision response for overlapping pairs
+    INTEGRATION,            // Applying accumulated forces and moving bodies
+    CLIPPING,               // Pushing bodies back out of the stadium
+    TOTAL,
+    COUNT
+};
+
+enum class PhysicsCounter : int {
+    STADIUM_CONTACTS = 0,   // Bodies touching a stadium
+    PAIR_TESTS,             // Bey-bey pairs tested
+    CONTACTS,               // Pairs found overlapping
+    IMPACTS,                // Pairs whose impact was applied (outside the collision cooldown)
+    COUNT
+};
+
+/**
+* Rolling average, 99th percentile and maximum over the recorded ticks. Times are in milliseconds.
+*/
+struct PhysicsStat {
+    double average = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+/**
+* Timers and counters for the phases of PhysicsWorld::step(). Only the interactive world has one, see
+* PhysicsWorld::enableProfiling(); headless simulation clones skip the clock reads.
+*
+* The stepping thread calls beginTick(), then mark() at the end of each phase, and endTick(). Time since the
+* previous mark is charged to the named phase, so nested phases (impacts inside the pair loop) are handled by
+* marking on either side of them. The last HISTORY_SIZE ticks are kept, and any thread may query them.
+*/
+class PhysicsProfiler {
+public:
+    static constexpr size_t HISTORY_SIZE = 512;     // A little over 2 s at 240 Hz
+
+    PhysicsProfiler() = default;
+    PhysicsProfiler(const PhysicsProfiler&) {}      // A copied world starts with empty history
+    PhysicsProfiler& operator=(const PhysicsProfiler&) { return *this; }
+
+    void beginTick() {
+        current = {};
+        tickStart = lastMark = Clock::now();
+    }
+    void mark(PhysicsPhase phase) {
+        Clock::time_point now = Clock::now();
+        current.nanoseconds[int(phase)] += std::chrono::duration_cast<std::chrono::nanoseconds>(now - lastMark).count();
+        lastMark = now;
+    }
+    void count(PhysicsCounter counter, uint32_t amount = 1) { current.counts[int(counter)] += amount; }
+    void endTick();
+
+    PhysicsStat getStat(PhysicsPhase phase) const;
+    PhysicsStat getStat(PhysicsCounter counter) const;
+    size_t getTickCount() const;
+    void reset();
+
+    static const char* getName(PhysicsPhase phase);
+    static const char* getName(PhysicsCounter counter);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct TickSample {
+        std::array<int64_t, size_t(PhysicsPhase::COUNT)> nanoseconds{};
+        std::array<uint32_t, size_t(PhysicsCounter::COUNT)> counts{};
+    };
+
+    template <typename Getter>
+    PhysicsStat computeStat(Getter getter) const;
+
+    // Stepping thread only
+    TickSample current;
+    Clock::time_point tickStart;
+    Clock::time_point lastMark;
+
+    // Shared with readers
+    mutable std::mutex historyMutex;
+    std::array<TickSample, HISTORY_SIZE> history{};
+    size_t historyCount = 0;
+    size_t historyNext = 0;
+};
+
+/**
+* One tick of an optional profiler, so PhysicsWorld::step() can record unconditionally. Every call is a no-op
+* without a profiler. Ends the tick on destruction, which covers early returns.
+*/
+class PhysicsProfileScope {
+public:
+    explicit PhysicsProfileScope(PhysicsProfiler* tickProfiler) : profiler(tickProfiler) { if (profiler) profiler->beginTick(); }
+    ~PhysicsProfileScope() { if (profiler) profiler->endTick(); }
+
+    PhysicsProfileScope(const PhysicsProfileScope&) = delete;
+    PhysicsProfileScope& operator=(const PhysicsProfileScope&) = delete;
+
+    void mark(PhysicsPhase phase) { if (profiler) profiler->mark(phase); }
+    void count(PhysicsCounter counter, uint32_t amount = 1) { if (profiler) profiler->count(counter, amount); }
+
+private:
+    PhysicsProfiler* profiler;
+};
@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+// PhysicsSnapshot.h -- Immutable physics state for rendering -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class BeybladeBody;
+
+/**
+* State of one beyblade at the end of a physics tick. body is only used as a key and must not be dereferenced
+* by readers, since the physics thread may be writing to it.
+*/
+struct BodySnapshot {
+    const BeybladeBody* body = nullptr;
+    glm::vec3 center{};
+    glm::vec3 velocity{};
+    glm::vec3 angularVelocity{};
+};
+
+/**
+* Everything the render thread needs from one physics tick. Published by PhysicsThread through a TripleBuffer.
+*/
+struct PhysicsSnapshot {
+    uint64_t tick = 0;
+    float time = 0.0f;
+    std::vector<BodySnapshot> bodies;
+
+    const BodySnapshot* find(const BeybladeBody* body) const {
+        for (const BodySnapshot& snapshot : bodies) {
+            if (snapshot.body == body) return &snapshot;
+        }
+        return nullptr;
+    }
+};
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// PhysicsThread.cpp -- Fixed rate physics thread -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <chrono>
+
+#include "PhysicsThread.h"
+
+#include "PhysicsWorld.h"
+
+using namespace std;
+
+PhysicsThread::~PhysicsThread() {
+    stop();
+}
+
+/**
+* Publish the current state and start ticking. The world must not be touched directly until stop().
+*/
+
+void PhysicsThread::start() {
+    if (running) return;
+    publishSnapshot();
+    running = true;
+    thread = std::thread(&PhysicsThread::run, this);
+}
+
+/**
+* Stop ticking and join. Pending commands are applied so none are lost.
+*/
+
+void PhysicsThread::stop() {
+    running = false;
+    if (thread.joinable()) thread.join();
+    runCommands();
+}
+
+/**
+* Queue a change to the world, applied on the physics thread before the next tick.
+*
+* @param command                [in] Function taking the world. Must not block.
+*/
+
+void PhysicsThread::post(function<void(PhysicsWorld&)> command) {
+    lock_guard<mutex> lock(commandMutex);
+    commands.push_back(std::move(command));
+}
+
+/**
+* Latest published state. Only call from the thread that owns rendering; the reference is valid until the next call.
+*/
+
+const PhysicsSnapshot& PhysicsThread::getSnapshot() {
+    return snapshots.getReadBuffer();
+}
+
+void PhysicsThread::run() {
+    using clock = chrono::steady_clock;
+    const auto step = chrono::duration_cast<clock::duration>(chrono::duration<float>(timeStep));
+
+    auto nextTick = clock::now();
+    while (running) {
+        runCommands();
+
+        auto now = clock::now();
+        if (paused) {
+            nextTick = now + step;
+            this_thread::sleep_for(step);
+            continue;
+        }
+
+        int ticks = 0;
+        while (nextTick <= now && ticks < MAX_TICKS_PER_WAKE) {
+            world->update(timeStep);
+            simulatedTime += timeStep;
+            ++tick;
+            ++ticks;
+            nextTick += step;
+        }
+        if (ticks == MAX_TICKS_PER_WAKE && nextTick < now) {
+            nextTick = now;
+        }
+        if (ticks > 0) publishSnapshot();
+
+        this_thread::sleep_until(nextTick);
+    }
+}
+
+void PhysicsThread::runCommands() {
+    vector<function<void(PhysicsWorld&)>> pending;
+    {
+        lock_guard<mutex> lock(commandMutex);
+        pending.swap(commands);
+    }
+    if (pending.empty()) return;
+
+    for (auto& command : pending) command(*world);
+    publishSnapshot();
+}
+
+void PhysicsThread::publishSnapshot() {
+    PhysicsSnapshot& snapshot = snapshots.getWriteBuffer();
+    snapshot.tick = tick;
+    snapshot.time = simulatedTime;
+    snapshot.bodies.clear();    // Keeps capacity, so steady state does not allocate
+
+    for (Beyblade* beyblade : world->getBeyblades()) {
+        BeybladeBody* body = beyblade->getBody();
+        snapshot.bodies.push_back({ body, body->getCenter().value(), body->getVelocity().value(), body->getAngularVelocity().value() });
+    }
+    snapshots.publish();
+}
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+// PhysicsThread.h -- Fixed rate physics thread include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "PhysicsSnapshot.h"
+#include "TripleBuffer.h"
+
+class PhysicsWorld;
+
+/**
+* Runs PhysicsWorld::update() on its own thread at a fixed time step, so a slow frame no longer slows the
+* simulation and a heavy tick no longer delays the frame.
+*
+* After every tick the body states are published as a PhysicsSnapshot. While the thread is running, the main
+* thread must only read physics state through getSnapshot() and must change it through post().
+*/
+class PhysicsThread {
+public:
+    PhysicsThread(PhysicsWorld* world, float timeStep = 1.0f / 240.0f) : world(world), timeStep(timeStep) {}
+    ~PhysicsThread();
+
+    PhysicsThread(const PhysicsThread&) = delete;
+    PhysicsThread& operator=(const PhysicsThread&) = delete;
+
+    void start();
+    void stop();
+    bool isRunning() const { return running; }
+
+    void setPaused(bool isPaused) { paused = isPaused; }
+    bool isPaused() const { return paused; }
+
+    void post(std::function<void(PhysicsWorld&)> command);
+    const PhysicsSnapshot& getSnapshot();
+
+    float getTimeStep() const { return timeStep; }
+
+private:
+    void run();
+    void runCommands();
+    void publishSnapshot();
+
+    PhysicsWorld* world;
+    const float timeStep;                           // Seconds of simulation per tick
+    static constexpr int MAX_TICKS_PER_WAKE = 8;    // Drop time rather than spiral if the thread falls behind
+
+    std::thread thread;
+    std::atomic<bool> running{ false };
+    std::atomic<bool> paused{ false };
+
+    std::mutex commandMutex;
+    std::vector<std::function<void(PhysicsWorld&)>> commands;
+
+    TripleBuffer<PhysicsSnapshot> snapshots;
+    uint64_t tick = 0;
+    float simulatedTime = 0.0f;
+};
@@ -7,8 +7,9 @@
 
 #include "PhysicsWorld.h"
 
-#include "ObjectShader.h"
+#include "DebugRenderer.h"
 #include "MessageLog.h"
+#include "PhysicsSnapshot.h"
 
 /**
 * Add a beyblade body to the scene.
@@ -50,25 +51,54 @@ void PhysicsWorld::removeStadium(Stadium* body) {
 void PhysicsWorld::update(float deltaTime) {
     extern void UISetRunState(bool isError, const std::string & msg);  // Defined in UI.h
 
+    tickBodies.clear();
+    for (Beyblade* beyblade : beyblades) tickBodies.push_back(beyblade->getBody());
+    tickStadiums.assign(stadiums.begin(), stadiums.end());
+
+    StepResult result = step(tickBodies, tickStadiums, deltaTime);
+    if (result.spinOut >= 0) {
+        MessageLog::getInstance().addMessage("Beyblade " + beyblades[result.spinOut]->getName() + " ran out of spin", MessageType::NORMAL);
+    }
+    else if (result.outOfBounds >= 0) {
+        MessageLog::getInstance().addMessage("Beyblade " + beyblades[result.outOfBounds]->getName() + " out of bounds", MessageType::NORMAL);
+    }
+}
+
+/**
+* Advance a set of bodies by one tick. This is the whole physics loop; update() runs it on the world's own
+* beyblades, and headless simulations (SimulationWorld) run it on their copies.
+*
+* @param bodies                 [in] Beyblade bodies to advance.
+* @param stadiumBodies          [in] Stadiums they interact with.
+* @param deltaTime              [in] Time increment in seconds.
+*
+* @return Which body, if any, ended the round. The tick stops early in that case.
+*/
+
+PhysicsWorld::StepResult PhysicsWorld::step(const std::vector<BeybladeBody*>& bodies, const std::vector<StadiumBody*>& stadiumBodies, float deltaTime) {
+    StepResult result;
     currTime += deltaTime;
+    PhysicsProfileScope profile(profiler.get());
     /**
     * Resolve bey-stadium collisions
     */
-    for (Beyblade* beyblade : beyblades) {
-        BeybladeBody* beybladeBody = beyblade->getBody();
+    for (size_t b = 0; b < bodies.size(); ++b) {
+        BeybladeBody* beybladeBody = bodies[b];
         if (beybladeBody->getAngularVelocity().length() < MIN_SPIN_THRESHOLD) {
-            MessageLog::getInstance().addMessage("Beyblade " + beyblade->getName() + " ran out of spin", MessageType::NORMAL);
-            return;
+            result.spinOut = int(b);
+            profile.mark(PhysicsPhase::STADIUM_CONTACT);
+            return result;
         }
 
         // Get position of the bottom tip
         Vec3_M beyBottom = beybladeBody->getBottomPosition();
 
         // Should usually only be one stadium, but may need to scale to more
-        for (Stadium* stadium : stadiums) {
+        for (StadiumBody* stadium : stadiumBodies) {
             if(!stadium->isInside(beyBottom.xTyped(), beyBottom.zTyped())) {
-                MessageLog::getInstance().addMessage("Beyblade " + beyblade->getName() + " out of bounds", MessageType::NORMAL);
-                return;
+                result.outOfBounds = int(b);
+                profile.mark(PhysicsPhase::STADIUM_CONTACT);
+                return result;
             }
 
             // Add air resistance
@@ -82,22 +112,27 @@ void PhysicsWorld::update(float deltaTime) {
             }
             else {
                 // Add friction and slope forces from contact
+                profile.count(PhysicsCounter::STADIUM_CONTACTS);
                 physics.accumulateFriction(beybladeBody, stadium);
                 physics.accumulateSlope(beybladeBody, stadium);
             }
         }
     }
+    profile.mark(PhysicsPhase::STADIUM_CONTACT);
+
     /**
     * Resolve bey-bey collisions
     */
-    for (size_t i = 0; i < beyblades.size(); ++i) {
-        for (size_t j = i + 1; j < beyblades.size(); ++j) {
-            BeybladeBody* bey1 = beyblades[i]->getBody();
-            BeybladeBody* bey2 = beyblades[j]->getBody();
+    for (size_t i = 0; i < bodies.size(); ++i) {
+        for (size_t j = i + 1; j < bodies.size(); ++j) {
+            BeybladeBody* bey1 = bodies[i];
+            BeybladeBody* bey2 = bodies[j];
             std::optional<M> contactDistance = BeybladeBody::distanceOverlap(bey1, bey2);
+            profile.count(PhysicsCounter::PAIR_TESTS);
 
             // Skip beys with no contact
             if (!contactDistance.has_value()) continue;
+            profile.count(PhysicsCounter::CONTACTS);
             if (currTime - bey1->prevCollision < epsilonTime || currTime - bey2->prevCollision < epsilonTime) {
                 continue;
             }
@@ -106,8 +141,11 @@ void PhysicsWorld::update(float deltaTime) {
             * Linear repulsive force combines the collision due to initial velocity with the recoil from spins
             * Angular draining force is the loss of spin of both beys due to colliding
             */
+            profile.mark(PhysicsPhase::PAIR_TESTS);
             physics.accumulateImpact(bey1, bey2, contactDistance.value());
             bey1->prevCollision = bey2->prevCollision = currTime;
+            profile.count(PhysicsCounter::IMPACTS);
+            profile.mark(PhysicsPhase::IMPACTS);
         }
     }
 
@@ -116,39 +154,84 @@ void PhysicsWorld::update(float deltaTime) {
     * Then, apply all at once to change velocities, then update positions with new velocities.
     */
 
-    for (Beyblade* beyblade : beyblades) {
-        BeybladeBody* beybladeBody = beyblade->getBody();
+    profile.mark(PhysicsPhase::PAIR_TESTS);
+
+    for (BeybladeBody* beybladeBody : bodies) {
         beybladeBody->applyAccumulatedChanges(deltaTime);
         beybladeBody->update(deltaTime);
-        for (Stadium* stadium : stadiums) {
-            // Prevent beyblade from ever clipping into the stadium during rendering
+    }
+    profile.mark(PhysicsPhase::INTEGRATION);
+
+    // Prevent beyblades from ever clipping into the stadium during rendering. Each body is independent,
+    // so doing this after all have moved gives the same result as doing it per body.
+    for (BeybladeBody* beybladeBody : bodies) {
+        for (StadiumBody* stadium : stadiumBodies) {
             physics.preventStadiumClipping(beybladeBody, stadium);
         }
     }
+    profile.mark(PhysicsPhase::CLIPPING);
+    return result;
 }
 
 /**
 * Debug render.
 * 
-* This currently shows all of the bounding boxes.  You can generate additional
-* debug here.
+* Adds the beyblade bounding boxes, velocities, the stadium normal under each
+* beyblade, and the normal of any bey-bey contact to the frame's debug lines.
+* You can generate additional debug here.
 * 
-* @param shader                 [in] Our custom ShaderProgram.
+* @param debugRenderer          [in] Batch that draws the lines at the end of the frame.
+* @param snapshot               [in] Positions to use while a PhysicsThread owns the bodies, otherwise nullptr.
 */
 
-// Limited to 100 per object otherwise FPS tanks
-void PhysicsWorld::renderDebug(ObjectShader& shader) const {
-    // Render all bounding boxes
+void PhysicsWorld::renderDebug(DebugRenderer& debugRenderer, const PhysicsSnapshot* snapshot) const {
+    const glm::vec3 VELOCITY_COLOR(0.2f, 1.0f, 0.2f);
+    const glm::vec3 NORMAL_COLOR(0.2f, 0.6f, 1.0f);
+    const glm::vec3 CONTACT_COLOR(1.0f, 0.3f, 0.2f);
+    const float VELOCITY_SCALE = 0.1f;          // Seconds of travel shown
+    const float NORMAL_LENGTH = 0.03f;
+
+    // Only fixed data is read from the bodies, the rest comes from the snapshot when there is one
+    std::vector<std::pair<glm::vec3, float>> circles;   // Center and layer radius, for contacts
     for (Beyblade* beyblade : beyblades) {
         BeybladeBody* beybladeBody = beyblade->getBody();
-        for (int i = 0; i < beybladeBody->boundingBoxes.size() && i < 100; i++) {
-            beybladeBody->boundingBoxes[i]->renderDebug(shader, beybladeBody->getCenter().value());
+        glm::vec3 center, velocity;
+        if (snapshot != nullptr) {
+            const BodySnapshot* bodySnapshot = snapshot->find(beybladeBody);
+            if (bodySnapshot == nullptr) continue;
+            center = bodySnapshot->center;
+            velocity = bodySnapshot->velocity;
         }
+        else {
+            center = beybladeBody->getCenter().value();
+            velocity = beybladeBody->getVelocity().value();
+        }
+
+        for (const BoundingBox* box : beybladeBody->boundingBoxes) {
+            box->renderDebug(debugRenderer, center);
+        }
+        debugRenderer.addArrow(center, velocity * VELOCITY_SCALE, VELOCITY_COLOR);
+
+        for (const Stadium* stadium : stadiums) {
+            if (!stadium->isInside(M(center.x), M(center.z))) continue;
+            glm::vec3 surface(center.x, stadium->getY(M(center.x), M(center.z)).value(), center.z);
+            glm::vec3 normal = stadium->getNormal(M(center.x), M(center.z)).value();
+            debugRenderer.addArrow(surface, normal * NORMAL_LENGTH, NORMAL_COLOR);
+        }
+
+        circles.push_back({ center, beybladeBody->layer->radius.value() });
     }
 
-    for (Stadium* stadium : stadiums) {
-        for (int i = 0; i < stadium->boundingBoxes.size() && i < 100; i++) {
-            stadium->boundingBoxes[i]->renderDebug(shader, stadium->getCenter().value());
+    // Contact normals wherever two layers overlap, treating them as circles in xz
+    for (size_t i = 0; i < circles.size(); ++i) {
+        for (size_t j = i + 1; j < circles.size(); ++j) {
+            glm::vec3 delta = circles[j].first - circles[i].first;
+            delta.y = 0.0f;
+            float distance = glm::length(delta);
+            if (distance <= 0.0f || distance >= circles[i].second + circles[j].second) continue;
+            glm::vec3 normal = delta / distance;
+            glm::vec3 contact = circles[i].first + normal * circles[i].second;
+            debugRenderer.addArrow(contact, normal * NORMAL_LENGTH, CONTACT_COLOR);
         }
     }
 }
@@ -5,23 +5,40 @@
 
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <unordered_map>
 
 #include <glm/glm.hpp>
 
 #include "Physics.h"
+#include "PhysicsProfiler.h"
 #include "Beyblade.h"
 #include "Stadium.h"
 
+class DebugRenderer;
 class GameEngine;
-class ObjectShader;
+struct PhysicsSnapshot;
 
 class PhysicsWorld {
 public:
+    /**
+    * How a tick ended. Indices refer to the bodies passed to step().
+    */
+    struct StepResult {
+        int spinOut = -1;           // Body that ran out of spin
+        int outOfBounds = -1;       // Body that left the stadium
+        bool finished() const { return spinOut >= 0 || outOfBounds >= 0; }
+    };
+
     PhysicsWorld(Scalar minSpin = 30.0__, Scalar maxSpin = 1500.0__, const Physics& physics = Physics())
         : MIN_SPIN_THRESHOLD(minSpin), MAX_SPIN_THRESHOLD(maxSpin), physics(physics) {
     }
+    // Copies (simulation clones) are never profiled
+    PhysicsWorld(const PhysicsWorld& other)
+        : physics(other.physics), beyblades(other.beyblades), stadiums(other.stadiums), currTime(other.currTime),
+        MIN_SPIN_THRESHOLD(other.MIN_SPIN_THRESHOLD), MAX_SPIN_THRESHOLD(other.MAX_SPIN_THRESHOLD) {
+    }
 
     void addBeyblade(Beyblade* body);
     void addStadium(Stadium* body);
@@ -40,17 +57,31 @@ public:
     };
 
     void update(float deltaTime);
-    void renderDebug(ObjectShader &shader) const;
+    StepResult step(const std::vector<BeybladeBody*>& bodies, const std::vector<StadiumBody*>& stadiumBodies, float deltaTime);
+    void renderDebug(DebugRenderer& debugRenderer, const PhysicsSnapshot* snapshot = nullptr) const;
 
     std::vector<Beyblade*>& getBeyblades() { return beyblades; }
     std::vector<Stadium*>& getStadiums() { return stadiums; }
+    const std::vector<Beyblade*>& getBeyblades() const { return beyblades; }
+    const std::vector<Stadium*>& getStadiums() const { return stadiums; }
+
+    Physics& getPhysics() { return physics; }
+    const Physics& getPhysics() const { return physics; }
+    float getTime() const { return currTime; }
+    void enableProfiling() { if (!profiler) profiler = std::make_unique<PhysicsProfiler>(); }
+    const PhysicsProfiler* getProfiler() const { return profiler.get(); }     // Null unless enableProfiling() was called
 
 private:
     Physics physics;
+    std::unique_ptr<PhysicsProfiler> profiler;  // Timings of step(), read by the F3 debug screen. Interactive world only
 
     std::vector<Beyblade*> beyblades;
     std::vector<Stadium*> stadiums;
 
+    // Rebuilt every update() so bodies swapped by Beyblade::update() are picked up. Kept to reuse capacity.
+    std::vector<BeybladeBody*> tickBodies;
+    std::vector<StadiumBody*> tickStadiums;
+
     float currTime = 0.0f;
     const float epsilonTime = 0.2f;                 // Cannot have collisions within 0.3 seconds of a previous one
     const Scalar MIN_SPIN_THRESHOLD = 30.0__;       // If a beyblade's |w| is less, the game ends due to spin finish
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// SimulationWorld.cpp -- Headless physics world -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "SimulationWorld.h"
+
+using namespace std;
+
+/**
+* Create a world from body values.
+*
+* @param rules                  [in] World whose physics constants and spin thresholds are used. Its bodies are ignored.
+* @param bodies                 [in] Beyblade bodies, copied. Their parts are shared and must not change while simulating.
+* @param stadiums               [in] Stadium bodies, copied.
+* @param seed                   [in] Seed for recoil sampling.
+*/
+
+SimulationWorld::SimulationWorld(const PhysicsWorld& rules, vector<BeybladeBody> bodies, vector<StadiumBody> stadiums, uint32_t seed)
+    : world(rules), bodies(std::move(bodies)), stadiums(std::move(stadiums)), generator(seed)
+{
+    world.resetPhysics();
+    world.getPhysics().logImpacts = false;
+    for (BeybladeBody& body : this->bodies) body.prevCollision = 0.0f;
+}
+
+/**
+* Copy the current physical state of a live world.
+*
+* @param source                 [in] World to copy. Only BeybladeBody and StadiumBody values are taken.
+* @param seed                   [in] Seed for recoil sampling.
+*
+* @return The new world, with its clock at zero.
+*/
+
+SimulationWorld SimulationWorld::clone(const PhysicsWorld& source, uint32_t seed) {
+    vector<BeybladeBody> bodies;
+    vector<StadiumBody> stadiums;
+    bodies.reserve(source.getBeyblades().size());
+    stadiums.reserve(source.getStadiums().size());
+
+    for (const Beyblade* beyblade : source.getBeyblades()) bodies.push_back(*beyblade->getBody());
+    for (const Stadium* stadium : source.getStadiums()) stadiums.push_back(static_cast<const StadiumBody&>(*stadium));
+
+    return SimulationWorld(source, std::move(bodies), std::move(stadiums), seed);
+}
+
+/**
+* Place a body at its launch point with its launch velocities, as PreBattleState does when applying settings.
+*
+* @param index                  [in] Body index.
+* @param launch                 [in] Launch parameters.
+*/
+
+void SimulationWorld::launch(size_t index, const LaunchParameters& launch) {
+    BeybladeBody& body = bodies[index];
+    body.resetPhysics(Vec3_M(launch.center));
+    body.setInitialLaunch(Vec3_M(launch.center), launch.velocity, launch.angularVelocity);
+    body.prevCollision = 0.0f;
+}
+
+/**
+* Advance all bodies by one tick.
+*
+* @param deltaTime              [in] Time increment in seconds.
+*
+* @return How the tick ended. Indices refer to getBody().
+*/
+
+PhysicsWorld::StepResult SimulationWorld::step(float deltaTime) {
+    bodyPointers.clear();
+    stadiumPointers.clear();
+    for (BeybladeBody& body : bodies) bodyPointers.push_back(&body);
+    for (StadiumBody& stadium : stadiums) stadiumPointers.push_back(&stadium);
+
+    world.getPhysics().recoilGenerator = &generator;
+    return world.step(bodyPointers, stadiumPointers, deltaTime);
+}
+
+/**
+* Step until a body spins out or leaves the stadium, or the time runs out.
+*
+* @param duration               [in] Maximum seconds to simulate.
+* @param deltaTime              [in] Time increment in seconds.
+*
+* @return How the run ended. finished() is false if time ran out first.
+*/
+
+PhysicsWorld::StepResult SimulationWorld::run(float duration, float deltaTime) {
+    PhysicsWorld::StepResult result;
+    float endTime = world.getTime() + duration;
+    while (world.getTime() < endTime) {
+        result = step(deltaTime);
+        if (result.finished()) break;
+    }
+    return result;
+}
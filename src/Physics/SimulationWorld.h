@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// SimulationWorld.h -- Headless physics world include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "PhysicsWorld.h"
+#include "BeybladeBody.h"
+#include "StadiumBody.h"
+
+/**
+* Everything the player chooses for one beyblade before the battle starts.
+*/
+struct LaunchParameters {
+    glm::vec3 center{};
+    glm::vec3 velocity{};
+    glm::vec3 angularVelocity{};
+
+    bool operator==(const LaunchParameters& other) const {
+        return center == other.center && velocity == other.velocity && angularVelocity == other.angularVelocity;
+    }
+    bool operator!=(const LaunchParameters& other) const { return !(*this == other); }
+};
+
+/**
+* A PhysicsWorld that owns copies of its bodies instead of pointing at Beyblade and Stadium game objects.
+*
+* Only the physical state is copied (no meshes, textures or GL objects), so a SimulationWorld is cheap to create
+* and to copy, and it can be stepped from any thread. Recoil is drawn from the world's own seeded generator, so
+* two worlds with the same seed and launches play out identically.
+*/
+class SimulationWorld {
+public:
+    SimulationWorld(const PhysicsWorld& rules, std::vector<BeybladeBody> bodies, std::vector<StadiumBody> stadiums, uint32_t seed = 0);
+
+    static SimulationWorld clone(const PhysicsWorld& source, uint32_t seed = 0);
+
+    void launch(size_t index, const LaunchParameters& launch);
+    PhysicsWorld::StepResult step(float deltaTime);
+    PhysicsWorld::StepResult run(float duration, float deltaTime);
+
+    size_t getBodyCount() const { return bodies.size(); }
+    const BeybladeBody& getBody(size_t index) const { return bodies[index]; }
+    const StadiumBody& getStadium(size_t index) const { return stadiums[index]; }
+    float getTime() const { return world.getTime(); }
+
+private:
+    PhysicsWorld world;                 // Rules and clock only; never holds game objects
+    std::vector<BeybladeBody> bodies;
+    std::vector<StadiumBody> stadiums;
+    std::mt19937 generator;
+
+    // Rebuilt every step() since a copied SimulationWorld must not point into the original
+    std::vector<BeybladeBody*> bodyPointers;
+    std::vector<StadiumBody*> stadiumPointers;
+};
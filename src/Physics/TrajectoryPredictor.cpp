@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+// TrajectoryPredictor.cpp -- Predicted launch paths -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+
+#include "TrajectoryPredictor.h"
+
+using namespace std;
+
+/**
+* Set the world to predict and the launch for each of its beyblades. Nothing is re-simulated if they are unchanged.
+*
+* @param source                 [in] Live world. Only read when the prediction restarts.
+* @param newLaunches            [in] One launch per beyblade, in the world's order.
+*/
+
+void TrajectoryPredictor::setLaunches(const PhysicsWorld& source, const vector<LaunchParameters>& newLaunches) {
+    if (this->source == &source && launches == newLaunches) return;
+    this->source = &source;
+    launches = newLaunches;
+    invalidate();
+}
+
+/**
+* Change how far ahead to predict. A longer horizon continues the current prediction.
+*
+* @param seconds                [in] Seconds of simulation to predict.
+*/
+
+void TrajectoryPredictor::setHorizon(float seconds) {
+    if (seconds == horizon) return;
+    if (seconds < horizon) {
+        horizon = seconds;
+        invalidate();
+        return;
+    }
+    horizon = seconds;
+    if (world && !ended) complete = false;
+}
+
+/**
+* Drop the prediction. The next advance() starts again from launch.
+*/
+
+void TrajectoryPredictor::invalidate() {
+    world.reset();
+    paths.clear();
+    complete = false;
+    ended = false;
+}
+
+/**
+* Run the prediction for at most budgetMs of wall time, continuing from where the last call stopped.
+*
+* @param budgetMs               [in] Wall time to spend, in milliseconds.
+*/
+
+void TrajectoryPredictor::advance(float budgetMs) {
+    using clock = chrono::steady_clock;
+    static constexpr int TICKS_PER_CLOCK_CHECK = 16;
+
+    if (complete || source == nullptr) return;
+    if (!world) restart();
+
+    auto deadline = clock::now() + chrono::duration_cast<clock::duration>(chrono::duration<float, milli>(budgetMs));
+    while (true) {
+        for (int i = 0; i < TICKS_PER_CLOCK_CHECK; ++i) {
+            PhysicsWorld::StepResult result = world->step(timeStep);
+            float time = world->getTime();
+
+            if (time >= nextSample || result.finished()) {
+                for (size_t b = 0; b < paths.size(); ++b) paths[b].push_back(world->getBody(b).getCenter().value());
+                nextSample += sampleInterval;
+            }
+            if (result.finished()) {
+                ended = true;
+                complete = true;
+                return;
+            }
+            if (time >= horizon) {
+                complete = true;
+                return;
+            }
+        }
+        if (clock::now() >= deadline) return;
+    }
+}
+
+void TrajectoryPredictor::restart() {
+    world = make_unique<SimulationWorld>(SimulationWorld::clone(*source));
+
+    size_t count = min(world->getBodyCount(), launches.size());
+    for (size_t b = 0; b < count; ++b) world->launch(b, launches[b]);
+
+    paths.assign(world->getBodyCount(), {});
+    for (size_t b = 0; b < paths.size(); ++b) paths[b].push_back(world->getBody(b).getCenter().value());
+    nextSample = sampleInterval;
+    complete = false;
+    ended = false;
+}
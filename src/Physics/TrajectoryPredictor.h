@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+// TrajectoryPredictor.h -- Predicted launch paths include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "SimulationWorld.h"
+
+/**
+* Predicts where each beyblade will go by fast-forwarding a SimulationWorld from the current launch parameters.
+*
+* The path is cached: advance() does nothing while the launches stay the same and the horizon is reached. Work is
+* spread over frames, each call running only as many ticks as fit in its time budget and resuming the saved world
+* on the next call. Since the launches only act at time zero, changing one restarts the simulation from launch;
+* raising the horizon continues from where the previous prediction stopped.
+*/
+class TrajectoryPredictor {
+public:
+    TrajectoryPredictor(float horizon = 3.0f, float timeStep = 1.0f / 240.0f, float sampleInterval = 1.0f / 30.0f)
+        : horizon(horizon), timeStep(timeStep), sampleInterval(sampleInterval) {}
+
+    void setLaunches(const PhysicsWorld& source, const std::vector<LaunchParameters>& launches);
+    void setHorizon(float seconds);
+    void invalidate();
+
+    void advance(float budgetMs = 2.0f);
+
+    bool isComplete() const { return complete; }
+    float getHorizon() const { return horizon; }
+    float getPredictedTime() const { return world ? world->getTime() : 0.0f; }
+    size_t getPathCount() const { return paths.size(); }
+    const std::vector<glm::vec3>& getPath(size_t index) const { return paths[index]; }
+
+private:
+    void restart();
+
+    float horizon;                  // Seconds to predict
+    const float timeStep;           // Matches PhysicsThread so the preview plays out like the battle
+    const float sampleInterval;     // Seconds between stored path points
+
+    const PhysicsWorld* source = nullptr;
+    std::vector<LaunchParameters> launches;
+    std::unique_ptr<SimulationWorld> world;     // Kept between calls to resume from
+    std::vector<std::vector<glm::vec3>> paths;
+    float nextSample = 0.0f;
+    bool complete = false;          // Horizon reached or the round ended
+    bool ended = false;             // A beyblade spun out or left the stadium
+};
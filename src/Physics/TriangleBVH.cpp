@@ -0,0 +1,255 @@
+////////////////////////////////////////////////////////////////////////////////
+// TriangleBVH.cpp -- Triangle bounding volume hierarchy -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cfloat>
+
+#include "TriangleBVH.h"
+
+using namespace std;
+using namespace glm;
+
+namespace {
+
+constexpr int BIN_COUNT = 12;
+constexpr uint32_t MIN_LEAF_SIZE = 4;       // Never split below this
+constexpr uint32_t MAX_LEAF_SIZE = 8;       // Always split above this
+constexpr float TRAVERSAL_COST = 1.0f;      // Relative to one triangle test
+constexpr uint32_t MAX_DEPTH = 48;          // Keeps raycast()'s stack bounded on degenerate input
+constexpr int STACK_SIZE = MAX_DEPTH + 2;
+
+struct Bounds {
+    vec3 min = vec3(FLT_MAX);
+    vec3 max = vec3(-FLT_MAX);
+
+    void grow(const vec3& point) {
+        min = glm::min(min, point);
+        max = glm::max(max, point);
+    }
+    void grow(const Bounds& other) {
+        min = glm::min(min, other.min);
+        max = glm::max(max, other.max);
+    }
+    float area() const {
+        vec3 extent = max - min;
+        if (extent.x < 0.0f) return 0.0f;
+        return extent.x * extent.y + extent.y * extent.z + extent.z * extent.x;
+    }
+};
+
+struct Bin {
+    Bounds bounds;
+    uint32_t count = 0;
+};
+
+bool intersectBox(const vec3& min, const vec3& max, const vec3& origin, const vec3& inverseDirection, float maxDistance, float& entry) {
+    vec3 t0 = (min - origin) * inverseDirection;
+    vec3 t1 = (max - origin) * inverseDirection;
+    vec3 tNear = glm::min(t0, t1);
+    vec3 tFar = glm::max(t0, t1);
+    entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    return entry <= exit;
+}
+
+}  // namespace
+
+/**
+* Build the hierarchy, replacing any previous one.
+*
+* @param vertices               [in] Vertex positions.
+* @param indices                [in] Triangle list.
+*/
+
+void TriangleBVH::build(const vector<vec3>& vertices, const vector<unsigned int>& indices) {
+    clear();
+    uint32_t triangleCount = uint32_t(indices.size() / 3);
+    if (triangleCount == 0) return;
+
+    vector<Bounds> triangleBounds(triangleCount);
+    vector<vec3> centroids(triangleCount);
+    vector<uint32_t> order(triangleCount);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        for (int c = 0; c < 3; ++c) triangleBounds[t].grow(vertices[indices[t * 3 + c]]);
+        centroids[t] = (triangleBounds[t].min + triangleBounds[t].max) * 0.5f;
+        order[t] = t;
+    }
+
+    nodes.reserve(2 * size_t(triangleCount));
+    nodes.push_back({ vec3(0.0f), 0, vec3(0.0f), triangleCount });
+
+    // Node index and depth
+    vector<pair<uint32_t, uint32_t>> pending = { { 0, 0 } };
+    while (!pending.empty()) {
+        auto [nodeIndex, depth] = pending.back();
+        pending.pop_back();
+        uint32_t first = nodes[nodeIndex].first;
+        uint32_t count = nodes[nodeIndex].count;
+
+        Bounds bounds, centroidBounds;
+        for (uint32_t i = first; i < first + count; ++i) {
+            bounds.grow(triangleBounds[order[i]]);
+            centroidBounds.grow(centroids[order[i]]);
+        }
+        nodes[nodeIndex].min = bounds.min;
+        nodes[nodeIndex].max = bounds.max;
+        if (count <= MIN_LEAF_SIZE || depth >= MAX_DEPTH) continue;
+
+        // Find the cheapest bin boundary over all three axes
+        int bestAxis = -1, bestSplit = 0;
+        float bestCost = FLT_MAX;
+        for (int axis = 0; axis < 3; ++axis) {
+            float lo = centroidBounds.min[axis], extent = centroidBounds.max[axis] - lo;
+            if (extent <= 0.0f) continue;
+            float scale = BIN_COUNT / extent;
+
+            Bin bins[BIN_COUNT];
+            for (uint32_t i = first; i < first + count; ++i) {
+                int b = std::min(BIN_COUNT - 1, int((centroids[order[i]][axis] - lo) * scale));
+                bins[b].bounds.grow(triangleBounds[order[i]]);
+                ++bins[b].count;
+            }
+
+            // Right to left sweep stores the right side's cost term, left to right completes it
+            float rightCost[BIN_COUNT];
+            Bounds right;
+            uint32_t rightCount = 0;
+            for (int b = BIN_COUNT - 1; b > 0; --b) {
+                right.grow(bins[b].bounds);
+                rightCount += bins[b].count;
+                rightCost[b] = right.area() * rightCount;
+            }
+            Bounds left;
+            uint32_t leftCount = 0;
+            for (int b = 0; b < BIN_COUNT - 1; ++b) {
+                left.grow(bins[b].bounds);
+                leftCount += bins[b].count;
+                if (leftCount == 0 || leftCount == count) continue;
+                float cost = left.area() * leftCount + rightCost[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b + 1;
+                }
+            }
+        }
+
+        // Both costs are relative to the node's area
+        float leafCost = float(count);
+        float splitCost = TRAVERSAL_COST + bestCost / std::max(bounds.area(), FLT_MIN);
+        if (bestAxis < 0 || (splitCost >= leafCost && count <= MAX_LEAF_SIZE)) continue;
+
+        float lo = centroidBounds.min[bestAxis];
+        float scale = BIN_COUNT / (centroidBounds.max[bestAxis] - lo);
+        uint32_t* middle = partition(order.data() + first, order.data() + first + count, [&](uint32_t t) {
+            return std::min(BIN_COUNT - 1, int((centroids[t][bestAxis] - lo) * scale)) < bestSplit;
+        });
+        uint32_t leftCount = uint32_t(middle - (order.data() + first));
+
+        uint32_t leftChild = uint32_t(nodes.size());
+        nodes.push_back({ vec3(0.0f), first, vec3(0.0f), leftCount });
+        nodes.push_back({ vec3(0.0f), first + leftCount, vec3(0.0f), count - leftCount });
+        nodes[nodeIndex].first = leftChild;
+        nodes[nodeIndex].count = 0;
+        pending.push_back({ leftChild, depth + 1 });
+        pending.push_back({ leftChild + 1, depth + 1 });
+    }
+    nodes.shrink_to_fit();
+
+    triangles.resize(triangleCount);
+    for (uint32_t i = 0; i < triangleCount; ++i) {
+        uint32_t t = order[i];
+        const vec3& v0 = vertices[indices[t * 3]];
+        triangles[i] = { v0, vertices[indices[t * 3 + 1]] - v0, vertices[indices[t * 3 + 2]] - v0, t };
+    }
+}
+
+void TriangleBVH::clear() {
+    nodes.clear();
+    triangles.clear();
+}
+
+/**
+* Find the nearest triangle a ray hits. Triangles are double sided.
+*
+* @param origin                 [in] Ray origin, in the coordinates the mesh was built in.
+* @param direction              [in] Ray direction. Need not be unit length.
+* @param maxDistance            [in] Ignore hits further than this, in units of direction's length.
+* @param hit                    [out] Nearest hit. Only set if there is one.
+*
+* @return true if the ray hits the mesh within maxDistance.
+*/
+
+bool TriangleBVH::raycast(const vec3& origin, const vec3& direction, float maxDistance, Hit& hit) const {
+    if (nodes.empty()) return false;
+
+    // Divide by zero gives infinities, which the slab test handles
+    vec3 inverseDirection = 1.0f / direction;
+    float nearest = maxDistance;
+    int64_t nearestTriangle = -1;
+
+    float entry;
+    if (!intersectBox(nodes[0].min, nodes[0].max, origin, inverseDirection, nearest, entry)) return false;
+
+    uint32_t stack[STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = nodes[stack[--stackSize]];
+
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                const Triangle& triangle = triangles[i];
+                vec3 p = cross(direction, triangle.edge2);
+                float determinant = dot(triangle.edge1, p);
+                if (std::abs(determinant) < 1e-12f) continue;
+
+                float inverseDeterminant = 1.0f / determinant;
+                vec3 s = origin - triangle.v0;
+                float u = dot(s, p) * inverseDeterminant;
+                if (u < 0.0f || u > 1.0f) continue;
+                vec3 q = cross(s, triangle.edge1);
+                float v = dot(direction, q) * inverseDeterminant;
+                if (v < 0.0f || u + v > 1.0f) continue;
+                float t = dot(triangle.edge2, q) * inverseDeterminant;
+                if (t >= 0.0f && t < nearest) {
+                    nearest = t;
+                    nearestTriangle = int64_t(i);
+                }
+            }
+            continue;
+        }
+
+        // Visit the nearer child first so the far one can be culled by the hits it finds
+        float leftEntry, rightEntry;
+        bool hitLeft = intersectBox(nodes[node.first].min, nodes[node.first].max, origin, inverseDirection, nearest, leftEntry);
+        bool hitRight = intersectBox(nodes[node.first + 1].min, nodes[node.first + 1].max, origin, inverseDirection, nearest, rightEntry);
+        if (hitLeft && hitRight) {
+            bool leftFirst = leftEntry <= rightEntry;
+            stack[stackSize++] = leftFirst ? node.first + 1 : node.first;
+            stack[stackSize++] = leftFirst ? node.first : node.first + 1;
+        }
+        else if (hitLeft) stack[stackSize++] = node.first;
+        else if (hitRight) stack[stackSize++] = node.first + 1;
+    }
+
+    if (nearestTriangle < 0) return false;
+
+    const Triangle& triangle = triangles[size_t(nearestTriangle)];
+    hit.distance = nearest;
+    hit.point = origin + direction * nearest;
+    hit.normal = normalize(cross(triangle.edge1, triangle.edge2));
+    if (dot(hit.normal, direction) > 0.0f) hit.normal = -hit.normal;
+    hit.triangle = triangle.source;
+    return true;
+}
+
+/**
+* Bytes held, for the debug screen.
+*/
+
+size_t TriangleBVH::getMemoryUsage() const {
+    return nodes.capacity() * sizeof(Node) + triangles.capacity() * sizeof(Triangle);
+}
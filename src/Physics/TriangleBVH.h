@@ -0,0 +1,59 @@
+////////////////////////////////////////////////////////////////////////////////
+// TriangleBVH.h -- Triangle bounding volume hierarchy include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/**
+* Bounding volume hierarchy over a static triangle mesh, for ray queries such as picking and camera collision.
+* Holds no GL state and about 60 bytes per triangle, so it can be rebuilt whenever the mesh is.
+*
+* Built top down with binned SAH (surface area heuristic): each split tries a few evenly spaced planes per axis and
+* keeps the one that minimizes the expected cost of a ray query.
+*/
+class TriangleBVH {
+public:
+    struct Hit {
+        float distance = 0.0f;          // Along the ray, in units of the direction's length
+        glm::vec3 point{};
+        glm::vec3 normal{};             // Unit, facing against the ray
+        uint32_t triangle = 0;          // Index into the indices passed to build(), divided by 3
+    };
+
+    void build(const std::vector<glm::vec3>& vertices, const std::vector<unsigned int>& indices);
+    void clear();
+
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, Hit& hit) const;
+
+    bool empty() const { return nodes.empty(); }
+    size_t getTriangleCount() const { return triangles.size(); }
+    size_t getNodeCount() const { return nodes.size(); }
+    size_t getMemoryUsage() const;
+
+private:
+    // Leaves have count > 0 and own triangles [first, first + count). Interior nodes have count == 0 and their
+    // children at first and first + 1.
+    struct Node {
+        glm::vec3 min;
+        uint32_t first;
+        glm::vec3 max;
+        uint32_t count;
+    };
+
+    // Stored ready for the Moller-Trumbore test
+    struct Triangle {
+        glm::vec3 v0;
+        glm::vec3 edge1;
+        glm::vec3 edge2;
+        uint32_t source;                // Original triangle index
+    };
+
+    std::vector<Node> nodes;
+    std::vector<Triangle> triangles;
+};
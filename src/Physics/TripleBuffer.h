@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////////////////////
+// TripleBuffer.h -- Lock-free single producer/consumer triple buffer -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/**
+* Hands the most recent value from one producer thread to one consumer thread without locks.
+*
+* The producer fills getWriteBuffer() and calls publish(). The consumer calls getReadBuffer(), which returns the
+* newest published value (or the previous one if nothing new was published). Neither side ever waits, and the
+* producer never touches the buffer the consumer is reading, so a returned reference stays valid until the
+* consumer's next getReadBuffer() call.
+*/
+template <typename T>
+class TripleBuffer {
+public:
+    T& getWriteBuffer() { return buffers[back]; }
+
+    void publish() {
+        back = middle.exchange(uint8_t(back | FRESH_BIT), std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    const T& getReadBuffer() {
+        if (middle.load(std::memory_order_acquire) & FRESH_BIT) {
+            front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+        }
+        return buffers[front];
+    }
+
+    bool hasFresh() const { return middle.load(std::memory_order_acquire) & FRESH_BIT; }
+
+private:
+    static constexpr uint8_t INDEX_MASK = 0x3;
+    static constexpr uint8_t FRESH_BIT = 0x4;
+
+    T buffers[3];
+    uint8_t back = 0;                       // Producer only
+    std::atomic<uint8_t> middle{ 1 };       // Last published slot, FRESH_BIT set until the consumer takes it
+    uint8_t front = 2;                      // Consumer only
+};
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////////////////////////
+// DebugRenderer.cpp -- Batched debug line drawing -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "DebugRenderer.h"
+
+#include "Buffers.h"
+#include "ShaderPath.h"
+#include "ShaderProgram.h"
+#include "StreamBuffer.h"
+#include "Utils.h"
+
+using namespace std;
+using namespace glm;
+
+static const std::vector<VertexAttribute> LINE_VERTEX_LAYOUT = {
+    { 3, VertexComponent::FLOAT, false },           // Position
+    { 4, VertexComponent::UNSIGNED_BYTE, true }     // Color
+};
+
+/**
+* Constructor. Needs a current GL context.
+*/
+
+DebugRenderer::DebugRenderer() {
+    // Attributes are pointed at the StreamBuffer by each flush()
+    glGenVertexArrays(1, &VAO);
+
+    shaderProgram = new ShaderProgram(DEBUG_VERTEX_SHADER_PATH, DEBUG_FRAGMENT_SHADER_PATH);
+}
+
+DebugRenderer::~DebugRenderer() {
+    glDeleteVertexArrays(1, &VAO);
+    delete shaderProgram;
+}
+
+void DebugRenderer::addLine(const vec3& from, const vec3& to, const vec3& color) {
+    uint32_t packed = packColor(color);
+    vertices.push_back({ from, packed });
+    vertices.push_back({ to, packed });
+}
+
+/**
+* Axis aligned box as its 12 edges.
+*/
+
+void DebugRenderer::addBox(const vec3& min, const vec3& max, const vec3& color) {
+    vec3 corners[8];
+    for (int i = 0; i < 8; ++i) {
+        corners[i] = vec3(i & 1 ? max.x : min.x, i & 2 ? max.y : min.y, i & 4 ? max.z : min.z);
+    }
+
+    // Each edge joins two corners that differ in one bit
+    for (int i = 0; i < 8; ++i) {
+        for (int bit = 1; bit < 8; bit <<= 1) {
+            if ((i & bit) == 0) addLine(corners[i], corners[i | bit], color);
+        }
+    }
+}
+
+/**
+* Line from origin to origin + vector, with a small head so the direction reads at a glance.
+*/
+
+void DebugRenderer::addArrow(const vec3& origin, const vec3& vector, const vec3& color) {
+    float len = length(vector);
+    if (len <= 0.0f) return;
+    vec3 tip = origin + vector;
+    addLine(origin, tip, color);
+
+    // Two barbs in a plane containing the shaft
+    vec3 direction = vector / len;
+    vec3 side = cross(direction, std::abs(direction.y) < 0.9f ? vec3(0.0f, 1.0f, 0.0f) : vec3(1.0f, 0.0f, 0.0f));
+    side = normalize(side) * len * 0.1f;
+    vec3 back = tip - direction * len * 0.2f;
+    addLine(tip, back + side, color);
+    addLine(tip, back - side, color);
+}
+
+/**
+* Connected line strip, e.g. a predicted trajectory.
+*/
+
+void DebugRenderer::addPath(const std::vector<vec3>& points, const vec3& color) {
+    for (size_t i = 1; i < points.size(); ++i) addLine(points[i - 1], points[i], color);
+}
+
+/**
+* Draw everything added since the last flush with one draw call, depth tested against the scene.
+*
+* @param viewProjection         [in] projection * view.
+*/
+
+void DebugRenderer::flush(const mat4& viewProjection) {
+    lastLineCount = vertices.size() / 2;
+    if (vertices.empty()) return;
+
+    shaderProgram->use();
+    shaderProgram->setMat4("viewProjection", viewProjection);
+
+    StreamBuffer& stream = StreamBuffer::getInstance();
+    size_t offset = stream.push(vertices.data(), vertices.size() * sizeof(LineVertex), sizeof(LineVertex));
+    glBindVertexArray(VAO);
+    bindVertexAttributes(stream.getBuffer(), offset, LINE_VERTEX_LAYOUT, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDrawArrays(GL_LINES, 0, GLsizei(vertices.size()));
+    glBindVertexArray(0);
+
+    vertices.clear();
+    GL_CHECK("DebugRenderer");
+}
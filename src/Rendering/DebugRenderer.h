@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+// DebugRenderer.h -- Batched debug line drawing include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+class ShaderProgram;
+
+/**
+* Immediate mode debug lines: boxes, vectors and paths are appended in world space during the frame and flush()
+* draws all of them with one GL_LINES call from the StreamBuffer. Nothing is kept between frames, so debug
+* geometry costs no GL objects per shape and no state outside flush().
+*/
+class DebugRenderer {
+public:
+    DebugRenderer();
+    ~DebugRenderer();
+
+    // Owns GL objects
+    DebugRenderer(const DebugRenderer&) = delete;
+    DebugRenderer& operator=(const DebugRenderer&) = delete;
+
+    void addLine(const glm::vec3& from, const glm::vec3& to, const glm::vec3& color);
+    void addBox(const glm::vec3& min, const glm::vec3& max, const glm::vec3& color);
+    void addArrow(const glm::vec3& origin, const glm::vec3& vector, const glm::vec3& color);
+    void addPath(const std::vector<glm::vec3>& points, const glm::vec3& color);
+
+    void flush(const glm::mat4& viewProjection);
+
+    size_t getLastLineCount() const { return lastLineCount; }
+
+private:
+    struct LineVertex {
+        glm::vec3 position;
+        uint32_t color;         // RGBA8
+    };
+
+    GLuint VAO = 0;
+    std::vector<LineVertex> vertices;           // Pairs, added since the last flush
+    size_t lastLineCount = 0;
+
+    ShaderProgram* shaderProgram{};
+};
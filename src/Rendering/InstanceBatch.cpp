@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+// InstanceBatch.cpp -- Instanced mesh batching -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cfloat>
+
+#include "InstanceBatch.h"
+
+#include "BeybladeMesh.h"
+#include "ObjectShader.h"
+#include "RenderQueue.h"
+
+/**
+* Queue one instance of a mesh.
+*
+* @param mesh                   [in] Mesh to draw. Must stay alive until the render queue is flushed.
+* @param model                  [in] Model matrix.
+* @param tint                   [in] Tint, where white has no effect.
+*/
+
+void InstanceBatch::add(BeybladeMesh* mesh, const glm::mat4& model, const glm::vec3& tint) {
+    batches[mesh].added.push_back({ model, tint });
+}
+
+/**
+* Hand everything added since the last submit to the render queue, one packet per mesh. Instances outside the view
+* frustum are dropped first, so a mesh with none left costs nothing.
+*
+* @param queue                  [in/out] Frame's render queue, after begin().
+* @param shader                 [in] Object shader with the frame's global parameters already set.
+*/
+
+void InstanceBatch::submit(RenderQueue& queue, ObjectShader& shader) {
+    lastDrawCalls = 0;
+    lastInstances = 0;
+
+    for (auto it = batches.begin(); it != batches.end();) {
+        BeybladeMesh* mesh = it->first;
+        MeshBatch& batch = it->second;
+        if (batch.added.empty()) {
+            it = batches.erase(it);     // Mesh not drawn this frame, may since have been freed
+            continue;
+        }
+
+        DrawPacket packet;
+        packet.shader = &shader;
+        packet.vao = mesh->getVAO();
+        packet.boundsMin = glm::vec3(FLT_MAX);
+        packet.boundsMax = glm::vec3(-FLT_MAX);
+
+        batch.visible.clear();
+        for (const InstanceData& instance : batch.added) {
+            glm::vec3 instanceMin, instanceMax;
+            RenderQueue::transformBounds(instance.model, mesh->boundingBox.min, mesh->boundingBox.max, instanceMin, instanceMax);
+            if (!queue.isVisible(instanceMin, instanceMax)) continue;
+            batch.visible.push_back(instance);
+            packet.boundsMin = glm::min(packet.boundsMin, instanceMin);
+            packet.boundsMax = glm::max(packet.boundsMax, instanceMax);
+        }
+        batch.added.clear();
+        ++it;
+        if (batch.visible.empty()) continue;
+
+        // The map's nodes do not move, so the vector is still there when the queue is flushed
+        std::vector<InstanceData>* visible = &batch.visible;
+        packet.draw = [mesh, visible](ObjectShader& boundShader, const DrawPacket&) {
+            boundShader.setObjectRenderParams(glm::mat4(1.0f), glm::vec3(1.0f));     // Tint still applies
+            boundShader.setInstanced(true);
+            mesh->renderInstanced(boundShader, visible->data(), visible->size());
+            boundShader.setInstanced(false);
+        };
+        queue.submit(packet);
+
+        ++lastDrawCalls;
+        lastInstances += int(batch.visible.size());
+    }
+}
@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+// InstanceBatch.h -- Instanced mesh batching include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class BeybladeMesh;
+class ObjectShader;
+class RenderQueue;
+
+/**
+* Per-instance vertex data, read by object.vs at locations 4-8 when "instanced" is set. The model must be rigid
+* (rotation and translation, or uniform scale), since object.vs uses it as its own normal matrix.
+*/
+struct InstanceData {
+    glm::mat4 model;
+    glm::vec3 tint;
+};
+
+/**
+* Collects beyblades over a frame and draws each distinct mesh with one glDrawElementsInstanced call,
+* so the number of draw calls depends on the number of meshes rather than the number of tops.
+*
+* Call add() for every beyblade, then submit() once before the render queue is flushed. Per-mesh vectors are kept
+* between frames to reuse their capacity.
+*/
+class InstanceBatch {
+public:
+    void add(BeybladeMesh* mesh, const glm::mat4& model, const glm::vec3& tint);
+    void submit(RenderQueue& queue, ObjectShader& shader);
+
+    int getLastDrawCalls() const { return lastDrawCalls; }
+    int getLastInstances() const { return lastInstances; }
+
+private:
+    struct MeshBatch {
+        std::vector<InstanceData> added;        // Since the last submit()
+        std::vector<InstanceData> visible;      // Drawn when the queue is flushed
+    };
+
+    std::unordered_map<BeybladeMesh*, MeshBatch> batches;
+    int lastDrawCalls = 0;
+    int lastInstances = 0;
+};
@@ -6,25 +6,67 @@
 #include "ObjectShader.h"
 
 ObjectShader::ObjectShader(const char* vertexPath, const char* fragmentPath)
-    : ShaderProgram(vertexPath, fragmentPath) {
+    : ShaderProgram(vertexPath, fragmentPath),
+    frameBuffer(FRAME_UNIFORM_BINDING, sizeof(FrameUniforms)),
+    objectRing(OBJECT_UNIFORM_BINDING, sizeof(ObjectUniforms)) {
+    bindUniformBlock("FrameData", FRAME_UNIFORM_BINDING);
+    bindUniformBlock("ObjectData", OBJECT_UNIFORM_BINDING);
+    frameBuffer.update(&frameUniforms);
+
+    instancedLocation = getUniformLocation("instanced");
+    stadiumSurfaceLocation = getUniformLocation("stadiumSurface");
+    stadiumRadiusLocation = getUniformLocation("stadiumRadius");
+    stadiumCurvatureLocation = getUniformLocation("stadiumCurvature");
+    stadiumVerticesPerRingLocation = getUniformLocation("stadiumVerticesPerRing");
+    stadiumNumRingsLocation = getUniformLocation("stadiumNumRings");
+    stadiumTextureScaleLocation = getUniformLocation("stadiumTextureScale");
+    stadiumRingColorLocation = getUniformLocation("stadiumRingColor");
+    stadiumCrossColorLocation = getUniformLocation("stadiumCrossColor");
+    stadiumBaseColorLocation = getUniformLocation("stadiumBaseColor");
 }
 
 void ObjectShader::setGlobalRenderParams(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos) const {
-    use();
-    setMat4("view", view);
-    setMat4("projection", projection);
-    setVec3("viewPos", viewPos);
+    frameUniforms.view = view;
+    frameUniforms.projection = projection;
+    frameUniforms.viewPos = glm::vec4(viewPos, 1.0f);
+    frameBuffer.update(&frameUniforms);
 }
 
 void ObjectShader::setObjectRenderParams(const glm::mat4& model, const glm::vec3& tint) const {
+    // Computed here once per object rather than per vertex
+    ObjectUniforms object;
+    object.model = model;
+    object.normalMatrix = glm::mat4(glm::transpose(glm::inverse(glm::mat3(model))));
+    object.tint = glm::vec4(tint, 1.0f);
+    objectRing.push(&object);
+}
+
+void ObjectShader::setInstanced(bool instanced) const {
     use();
-    setMat4("model", model);
-    setVec3("tint", tint);
+    setInt(instancedLocation, instanced ? 1 : 0);
 }
 
-void ObjectShader::setLight(LightType lightType, const glm::vec3& lightColor, const glm::vec3& lightPos) const {
+void ObjectShader::setStadiumSurface(bool enabled) const {
     use();
-    setInt("lightType", static_cast<int>(lightType));
-    setVec3("lightColor", lightColor);
-    setVec3("lightPos", lightPos);
+    setInt(stadiumSurfaceLocation, enabled ? 1 : 0);
+}
+
+void ObjectShader::setStadiumParams(float radius, float scaledCurvature, int verticesPerRing, int numRings, float textureScale,
+    const glm::vec3& ringColor, const glm::vec3& crossColor, const glm::vec3& baseColor) const {
+    use();
+    setFloat(stadiumRadiusLocation, radius);
+    setFloat(stadiumCurvatureLocation, scaledCurvature);
+    setInt(stadiumVerticesPerRingLocation, verticesPerRing);
+    setInt(stadiumNumRingsLocation, numRings);
+    setFloat(stadiumTextureScaleLocation, textureScale);
+    setVec3(stadiumRingColorLocation, ringColor);
+    setVec3(stadiumCrossColorLocation, crossColor);
+    setVec3(stadiumBaseColorLocation, baseColor);
+}
+
+void ObjectShader::setLight(LightType lightType, const glm::vec3& lightColor, const glm::vec3& lightPos) const {
+    frameUniforms.lightType = static_cast<int32_t>(lightType);
+    frameUniforms.lightColor = glm::vec4(lightColor, 1.0f);
+    frameUniforms.lightPos = glm::vec4(lightPos, 0.0f);
+    frameBuffer.update(&frameUniforms);
 }
@@ -5,8 +5,11 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include <glm/glm.hpp>
 #include "ShaderProgram.h"
+#include "UniformBuffer.h"
 
 enum LightType {
     Directional = 0,
@@ -14,7 +17,30 @@ enum LightType {
     // Future: Spotlight = 2
 };
 
+// FrameData block in object.vs and object.fs, std140
+struct FrameUniforms {
+    glm::mat4 view = glm::mat4(1.0f);
+    glm::mat4 projection = glm::mat4(1.0f);
+    glm::vec4 viewPos = glm::vec4(0.0f);
+    glm::vec4 lightColor = glm::vec4(1.0f);
+    glm::vec4 lightPos = glm::vec4(0.0f, -1.0f, 0.0f, 0.0f);   // Point light position or directional light direction
+    int32_t lightType = Directional;
+    int32_t padding[3] = {};
+};
+static_assert(sizeof(FrameUniforms) == 192, "FrameUniforms must match the std140 FrameData block");
+
+// ObjectData block in object.vs and object.fs, std140
+struct ObjectUniforms {
+    glm::mat4 model;
+    glm::mat4 normalMatrix;     // Upper 3x3 is transpose(inverse(model))
+    glm::vec4 tint;
+};
+static_assert(sizeof(ObjectUniforms) == 144, "ObjectUniforms must match the std140 ObjectData block");
 
+/**
+* Frame globals live in one uniform buffer and per-object data in a ring of them, so neither is tied to the program;
+* the remaining plain uniforms are looked up once, when the program is linked.
+*/
 class ObjectShader : public ShaderProgram {
 public:
     ObjectShader(const char* vertexPath, const char* fragmentPath);
@@ -22,9 +48,34 @@ public:
     // Global parameters - set once per frame
     void setGlobalRenderParams(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos) const;
 
-    // Object-specific parameters - set for each object
+    // Object-specific parameters - set for each object, before its draw call
     void setObjectRenderParams(const glm::mat4& model, const glm::vec3& tint) const;
 
+    // Take model and tint from per-instance attributes instead of uniforms (see InstanceBatch)
+    void setInstanced(bool instanced) const;
+
+    // Generate the stadium surface from gl_VertexID instead of the vertex attributes (see Stadium::render)
+    void setStadiumSurface(bool enabled) const;
+    void setStadiumParams(float radius, float scaledCurvature, int verticesPerRing, int numRings, float textureScale,
+        const glm::vec3& ringColor, const glm::vec3& crossColor, const glm::vec3& baseColor) const;
+
     // Lighting parameters - optional (set in shader by default)
     void setLight(LightType lightType, const glm::vec3& lightColor, const glm::vec3& lightPos) const;
+
+private:
+    mutable FrameUniforms frameUniforms;
+    UniformBuffer frameBuffer;
+    UniformRing objectRing;
+
+    // Resolved at link time
+    GLint instancedLocation;
+    GLint stadiumSurfaceLocation;
+    GLint stadiumRadiusLocation;
+    GLint stadiumCurvatureLocation;
+    GLint stadiumVerticesPerRingLocation;
+    GLint stadiumNumRingsLocation;
+    GLint stadiumTextureScaleLocation;
+    GLint stadiumRingColorLocation;
+    GLint stadiumCrossColorLocation;
+    GLint stadiumBaseColorLocation;
 };
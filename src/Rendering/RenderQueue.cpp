@@ -0,0 +1,171 @@
+////////////////////////////////////////////////////////////////////////////////
+// RenderQueue.cpp -- Culled, state-sorted draw submission -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+
+#include "RenderQueue.h"
+
+#include "ObjectShader.h"
+#include "Texture.h"
+#include "Utils.h"
+
+using namespace std;
+using namespace glm;
+
+/**
+* Extract the planes (Gribb and Hartmann): each is the last row of the matrix plus or minus one of the others.
+*
+* @param viewProjection         [in] projection * view.
+*/
+
+void Frustum::update(const mat4& viewProjection) {
+    // glm is column major, so row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+    auto row = [&](int i) {
+        return vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+    };
+    vec4 last = row(3);
+    for (int axis = 0; axis < 3; ++axis) {
+        planes[axis * 2] = last + row(axis);
+        planes[axis * 2 + 1] = last - row(axis);
+    }
+    for (vec4& plane : planes) plane /= length(vec3(plane));
+}
+
+/**
+* Conservative box test: false only if the box is entirely behind one plane. Boxes near a frustum corner can pass
+* while outside, which just costs a draw.
+*/
+
+bool Frustum::intersects(const vec3& boundsMin, const vec3& boundsMax) const {
+    for (const vec4& plane : planes) {
+        // The corner furthest along the plane normal
+        vec3 corner(plane.x >= 0.0f ? boundsMax.x : boundsMin.x,
+            plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+            plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+        if (dot(vec3(plane), corner) + plane.w < 0.0f) return false;
+    }
+    return true;
+}
+
+/**
+* World space box around a transformed local box (Arvo's method).
+*
+* @param model                  [in] Local to world transform.
+* @param localMin               [in] Local box minimum.
+* @param localMax               [in] Local box maximum.
+* @param worldMin               [out] World box minimum.
+* @param worldMax               [out] World box maximum.
+*/
+
+void RenderQueue::transformBounds(const mat4& model, const vec3& localMin, const vec3& localMax, vec3& worldMin, vec3& worldMax) {
+    worldMin = worldMax = vec3(model[3]);
+    for (int column = 0; column < 3; ++column) {
+        vec3 a = vec3(model[column]) * localMin[column];
+        vec3 b = vec3(model[column]) * localMax[column];
+        worldMin += glm::min(a, b);
+        worldMax += glm::max(a, b);
+    }
+}
+
+/**
+* Start a frame.
+*
+* @param view                   [in] Camera view matrix.
+* @param projection             [in] Camera projection matrix.
+* @param viewPos                [in] Camera position, for front to back ordering.
+*/
+
+void RenderQueue::begin(const mat4& view, const mat4& projection, const vec3& viewPos) {
+    frustum.update(projection * view);
+    this->viewPos = viewPos;
+    packets.clear();
+    stats = RenderStats();
+}
+
+/**
+* Queue a draw for flush(), unless it is outside the view frustum.
+*
+* @param packet                 [in] Draw state. Anything it points to must stay alive until flush().
+*/
+
+void RenderQueue::submit(const DrawPacket& packet) {
+    ++stats.submitted;
+    if (!frustum.intersects(packet.boundsMin, packet.boundsMax)) {
+        ++stats.culled;
+        return;
+    }
+    packets.push_back(packet);
+}
+
+/**
+* Shader in the top 8 bits, then texture and VAO in 12 bits each, then depth. GL names are small integers, so
+* truncating them only risks two objects sharing a group, never a wrong draw.
+*/
+
+uint64_t RenderQueue::makeSortKey(const DrawPacket& packet) const {
+    uint64_t shader = packet.shader->ID & 0xFF;
+    // Untextured packets go last and keep the texture of the draw before them, as when drawn in submission order
+    uint64_t texture = packet.texture ? std::min<uint64_t>(packet.texture->ID, 0xFFE) : 0xFFF;
+    uint64_t vao = packet.vao & 0xFFF;
+
+    // The bits of a non-negative float sort the same way as its value
+    float distance = length((packet.boundsMin + packet.boundsMax) * 0.5f - viewPos);
+    uint32_t depth;
+    memcpy(&depth, &distance, sizeof(depth));
+
+    return shader << 56 | texture << 44 | vao << 32 | depth;
+}
+
+/**
+* Draw everything queued since begin() and record the frame's counters.
+*/
+
+void RenderQueue::flush() {
+    order.clear();
+    for (uint32_t i = 0; i < uint32_t(packets.size()); ++i) order.push_back({ makeSortKey(packets[i]), i });
+    sort(order.begin(), order.end());
+
+    // Zero is a valid texture and VAO, so "nothing bound yet" needs its own value
+    const GLuint UNKNOWN = ~GLuint(0);
+    ObjectShader* boundShader = nullptr;
+    GLuint boundTexture = UNKNOWN;
+    GLuint boundVAO = UNKNOWN;
+
+    for (const auto& [key, index] : order) {
+        const DrawPacket& packet = packets[index];
+
+        if (packet.shader != boundShader) {
+            packet.shader->use();
+            boundShader = packet.shader;
+            ++stats.shaderChanges;
+        }
+        if (packet.texture && packet.texture->ID != boundTexture) {
+            packet.texture->use();
+            boundTexture = packet.texture->ID;
+            ++stats.textureChanges;
+        }
+        if (packet.vao != boundVAO) {
+            glBindVertexArray(packet.vao);
+            boundVAO = packet.vao;
+            ++stats.vaoChanges;
+        }
+
+        if (packet.draw) {
+            packet.draw(*boundShader, packet);
+            boundVAO = UNKNOWN;
+        }
+        else {
+            boundShader->setObjectRenderParams(packet.model, packet.tint);
+            glDrawElements(GL_TRIANGLES, packet.indexCount, GL_UNSIGNED_INT, (void*)(packet.firstIndex * sizeof(unsigned int)));
+        }
+        ++stats.drawCalls;
+    }
+    glBindVertexArray(0);
+
+    packets.clear();
+    lastStats = stats;
+    GL_CHECK("RenderQueue");
+}
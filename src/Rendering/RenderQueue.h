@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////
+// RenderQueue.h -- Culled, state-sorted draw submission include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+class ObjectShader;
+class Texture;
+
+/**
+* View frustum as six inward facing planes (xyz normal, w distance), taken from a view-projection matrix.
+*/
+struct Frustum {
+    glm::vec4 planes[6]{};
+
+    void update(const glm::mat4& viewProjection);
+    bool intersects(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+};
+
+/**
+* One draw call's worth of state. Bounds are in world space and are used for culling and for the depth part of the
+* sort key.
+*
+* Without a draw function the queue sets model and tint and draws indexCount indices starting at firstIndex.
+* With one, the queue binds the shader, texture and VAO and leaves the rest to it, e.g. extra uniforms or an
+* instanced draw. It must leave the shader and texture bound, but may change the VAO.
+*/
+struct DrawPacket {
+    ObjectShader* shader = nullptr;
+    const Texture* texture = nullptr;           // nullptr leaves whatever texture is bound
+    GLuint vao = 0;
+    GLsizei indexCount = 0;
+    size_t firstIndex = 0;
+
+    glm::mat4 model = glm::mat4(1.0f);
+    glm::vec3 tint = glm::vec3(1.0f);
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+
+    std::function<void(ObjectShader& shader, const DrawPacket& packet)> draw;
+};
+
+/**
+* Per-frame counters, shown on the F3 debug screen.
+*/
+struct RenderStats {
+    int submitted = 0;
+    int culled = 0;
+    int drawCalls = 0;
+    int shaderChanges = 0;
+    int textureChanges = 0;
+    int vaoChanges = 0;
+};
+
+/**
+* Collects a frame's draws, drops the ones outside the view frustum and issues the rest sorted by shader, texture,
+* VAO and then front to back, skipping binds that would not change anything.
+*
+* Call begin() once the camera is known, submit() every object, then flush().
+* The packet vector is kept between frames to reuse its capacity.
+*/
+class RenderQueue {
+public:
+    void begin(const glm::mat4& view, const glm::mat4& projection, const glm::vec3& viewPos);
+    void submit(const DrawPacket& packet);
+    void flush();
+
+    // For callers that cull finer than a packet, e.g. per instance
+    bool isVisible(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const { return frustum.intersects(boundsMin, boundsMax); }
+
+    const RenderStats& getLastStats() const { return lastStats; }
+
+    static void transformBounds(const glm::mat4& model, const glm::vec3& localMin, const glm::vec3& localMax,
+        glm::vec3& worldMin, glm::vec3& worldMax);
+
+private:
+    Frustum frustum;
+    glm::vec3 viewPos{};
+
+    std::vector<DrawPacket> packets;
+    std::vector<std::pair<uint64_t, uint32_t>> order;   // Sort key and packet index
+    RenderStats stats;
+    RenderStats lastStats;
+
+    uint64_t makeSortKey(const DrawPacket& packet) const;
+};
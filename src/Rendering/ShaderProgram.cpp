@@ -41,6 +41,22 @@ ShaderProgram::ShaderProgram(const char* vertexPath, const char* fragmentPath) {
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
 
+    // Resolve every active uniform now, so setters never have to ask GL. Array uniforms are reported as "name[0]".
+    GLint uniformCount = 0;
+    glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &uniformCount);
+    for (GLint i = 0; i < uniformCount; ++i) {
+        GLchar name[256];
+        GLsizei length;
+        GLint size;
+        GLenum type;
+        glGetActiveUniform(ID, GLuint(i), sizeof(name), &length, &size, &type, name);
+        std::string uniformName(name, length);
+        if (uniformName.size() > 3 && uniformName.compare(uniformName.size() - 3, 3, "[0]") == 0) {
+            uniformName.resize(uniformName.size() - 3);
+        }
+        uniformCache[uniformName] = glGetUniformLocation(ID, name);     // -1 for members of uniform blocks
+    }
+
     use(); // Use by default
 }
 
@@ -98,20 +114,42 @@ void ShaderProgram::use() const {
 
 /* Private Helper Methods */
 GLint ShaderProgram::getCachedUniformLocation(const std::string& name) const {
-    // Check cache first
-    if (uniformCache.find(name) != uniformCache.end()) {
-        return uniformCache[name];
+    // Every active uniform was cached at link time
+    auto it = uniformCache.find(name);
+    if (it != uniformCache.end()) {
+        return it->second;
     }
 
-    // Fetch from OpenGL and cache it
-    GLint location = glGetUniformLocation(ID, name.c_str());
-    if (location != -1) {
-        uniformCache[name] = location;
-    }
-    else {
-        std::cerr << "WARNING::UNIFORM::NOT_FOUND::" << name << std::endl;
+    // Not in the program (or optimized out). Cache the miss so the warning is only printed once.
+    std::cerr << "WARNING::UNIFORM::NOT_FOUND::" << name << std::endl;
+    uniformCache[name] = -1;
+    return -1;
+}
+
+/**
+ * Location of a uniform, for the GLint setters. Meant to be called once, e.g. from a derived constructor.
+ *
+ * @param name       Uniform name.
+ *
+ * @return The location, or -1 (ignored by the setters) if the program has no such uniform.
+ */
+GLint ShaderProgram::getUniformLocation(const char* name) const {
+    return getCachedUniformLocation(name);
+}
+
+/**
+ * Point a uniform block at a binding point (see UniformBinding). GLSL 3.30 cannot do this in the shader.
+ *
+ * @param name          Block name.
+ * @param bindingPoint  Binding point.
+ */
+void ShaderProgram::bindUniformBlock(const char* name, GLuint bindingPoint) const {
+    GLuint index = glGetUniformBlockIndex(ID, name);
+    if (index == GL_INVALID_INDEX) {
+        std::cerr << "WARNING::UNIFORM_BLOCK::NOT_FOUND::" << name << std::endl;
+        return;
     }
-    return location;
+    glUniformBlockBinding(ID, index, bindingPoint);
 }
 
 void ShaderProgram::setMat4(const std::string& name, const glm::mat4& mat) const {
@@ -149,6 +187,22 @@ void ShaderProgram::setInt(const std::string& name, int value) const {
     }
 }
 
+void ShaderProgram::setMat4(GLint location, const glm::mat4& mat) const {
+    if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(mat));
+}
+
+void ShaderProgram::setVec3(GLint location, const glm::vec3& vec) const {
+    if (location != -1) glUniform3fv(location, 1, glm::value_ptr(vec));
+}
+
+void ShaderProgram::setFloat(GLint location, float value) const {
+    if (location != -1) glUniform1f(location, value);
+}
+
+void ShaderProgram::setInt(GLint location, int value) const {
+    if (location != -1) glUniform1i(location, value);
+}
+
 // DO NOT TOUCH
 void ShaderProgram::setTint(const glm::vec3& color) const
 {
@@ -28,6 +28,12 @@ public:
     void setFloat(const std::string& name, float value) const;
     void setInt(const std::string& name, int value) const;
 
+    // Same, with a location from getUniformLocation(). For uniforms set every draw.
+    void setMat4(GLint location, const glm::mat4& mat) const;
+    void setVec3(GLint location, const glm::vec3& vec) const;
+    void setFloat(GLint location, float value) const;
+    void setInt(GLint location, int value) const;
+
     void setTint(const glm::vec3& color) const;
     //void debugUniforms(const std::vector<std::string>& uniformNames) const;
 
@@ -35,6 +41,8 @@ protected:
     mutable std::unordered_map<std::string, GLint> uniformCache;
 
     GLint getCachedUniformLocation(const std::string& name) const;
+    GLint getUniformLocation(const char* name) const;
+    void bindUniformBlock(const char* name, GLuint bindingPoint) const;
     GLuint compileShader(GLenum type, const char* source);
     static std::string readFile(const char* filePath);
 };
@@ -0,0 +1,173 @@
+////////////////////////////////////////////////////////////////////////////////
+// StreamBuffer.cpp -- Shared per-frame streaming buffer -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "StreamBuffer.h"
+
+#include "Utils.h"
+
+using namespace std;
+
+StreamBuffer& StreamBuffer::getInstance() {
+    static StreamBuffer instance;
+    return instance;
+}
+
+/**
+* (Re)create the buffer, empty and unfenced. Draws already issued from an old buffer are unaffected, since GL only
+* frees it once they are done.
+*
+* @param newPartitionSize       [in] Bytes per frame.
+*/
+
+void StreamBuffer::create(size_t newPartitionSize) {
+    destroy();
+
+    // Partitions start on a 64 KB boundary, so offsets aligned within one are aligned in the buffer
+    partitionSize = (newPartitionSize + 0xFFFF) & ~size_t(0xFFFF);
+    size_t size = partitionSize * PARTITION_COUNT;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    persistent = GLEW_ARB_buffer_storage;
+    if (persistent) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_COPY_WRITE_BUFFER, size, nullptr, flags);
+        mapped = static_cast<unsigned char*>(glMapBufferRange(GL_COPY_WRITE_BUFFER, 0, size, flags));
+        if (mapped == nullptr) {
+            std::cerr << "StreamBuffer: persistent mapping failed, using glBufferSubData" << std::endl;
+            glDeleteBuffers(1, &buffer);
+            glGenBuffers(1, &buffer);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            persistent = false;
+        }
+    }
+    if (!persistent) {
+        glBufferData(GL_COPY_WRITE_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    partition = 0;
+    offset = 0;
+}
+
+void StreamBuffer::destroy() {
+    for (GLsync& fence : fences) {
+        if (fence != nullptr) glDeleteSync(fence);
+        fence = nullptr;
+    }
+    if (buffer != 0) {
+        if (mapped != nullptr) {
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glUnmapBuffer(GL_COPY_WRITE_BUFFER);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        }
+        glDeleteBuffers(1, &buffer);
+    }
+    buffer = 0;
+    mapped = nullptr;
+}
+
+/**
+* Copy data into this frame's partition.
+*
+* @param data                   [in] Bytes to copy.
+* @param size                   [in] Byte count.
+* @param alignment              [in] Required alignment of the returned offset, e.g. the vertex size or
+*                               GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+*
+* @return Offset of the copy in getBuffer().
+*/
+
+size_t StreamBuffer::push(const void* data, size_t size, size_t alignment) {
+    if (buffer == 0) create(partitionSize);
+
+    size_t start = (offset + alignment - 1) / alignment * alignment;
+    if (start + size > partitionSize) {
+        // This frame needs more than a partition: start over in a bigger buffer rather than overwrite
+        create(std::max(partitionSize * 2, size + alignment));
+        ++stats.orphans;
+        start = 0;
+    }
+
+    size_t bufferOffset = size_t(partition) * partitionSize + start;
+    if (persistent) {
+        memcpy(mapped + bufferOffset, data, size);
+    }
+    else {
+        // A map per push (one per draw for UniformRing) costs more than the driver's own staging copy
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferSubData(GL_COPY_WRITE_BUFFER, bufferOffset, size, data);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    offset = start + size;
+    stats.bytes += size;
+    ++stats.allocations;
+    return bufferOffset;
+}
+
+/**
+* Make sure the GPU is done with a partition before it is written again.
+*/
+
+void StreamBuffer::waitForPartition(int index) {
+    GLsync& fence = fences[index];
+    if (fence == nullptr) return;
+
+    GLenum status = glClientWaitSync(fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+        if (!persistent) {
+            // Let the driver hand out fresh storage instead of waiting
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glBufferData(GL_COPY_WRITE_BUFFER, partitionSize * PARTITION_COUNT, nullptr, GL_STREAM_DRAW);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+            for (GLsync& other : fences) {
+                if (other != nullptr) glDeleteSync(other);
+                other = nullptr;
+            }
+            ++stats.orphans;
+            return;
+        }
+
+        auto start = chrono::steady_clock::now();
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);     // 1 ms
+        } while (status == GL_TIMEOUT_EXPIRED);
+        ++stats.stalls;
+        stats.stallMs += chrono::duration<float, milli>(chrono::steady_clock::now() - start).count();
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+/**
+* Fence this frame's partition and move to the next one. Call once per frame after the last draw.
+*/
+
+void StreamBuffer::endFrame() {
+    if (buffer != 0) {
+        fences[partition] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        partition = (partition + 1) % PARTITION_COUNT;
+        offset = 0;
+        waitForPartition(partition);
+        GL_CHECK("StreamBuffer");
+    }
+    lastStats = stats;
+    stats = StreamStats();
+}
+
+/**
+* Release the GL objects. Call while the context is current.
+*/
+
+void StreamBuffer::cleanup() {
+    destroy();
+    partitionSize = DEFAULT_PARTITION_SIZE;
+}
@@ -0,0 +1,69 @@
+////////////////////////////////////////////////////////////////////////////////
+// StreamBuffer.h -- Shared per-frame streaming buffer include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+#include <GL/glew.h>
+
+// Streaming counters for one frame, shown on the F3 debug screen
+struct StreamStats {
+    size_t bytes = 0;               // Pushed this frame
+    int allocations = 0;
+    int stalls = 0;                 // Frames that had to wait for the GPU to release a partition
+    float stallMs = 0.0f;
+    int orphans = 0;                // Times the buffer was orphaned or regrown instead of waiting
+};
+
+/**
+* One buffer shared by everything that uploads data every frame: text and debug line vertices, per-draw uniform
+* blocks, instance data. It is split into PARTITION_COUNT partitions used round robin, one per frame, each guarded
+* by a fence placed at endFrame(), so the CPU only writes where the GPU has finished reading.
+*
+* With ARB_buffer_storage the buffer is mapped once, persistently, and push() is a memcpy. Without it push() uses
+* glBufferSubData, and a partition still in use is orphaned rather than waited on.
+*
+* Data pushed is valid for draws issued in the same frame. getBuffer() may change when a frame outgrows its
+* partition, so read it after push().
+*/
+class StreamBuffer {
+public:
+    static constexpr int PARTITION_COUNT = 3;
+    static constexpr size_t DEFAULT_PARTITION_SIZE = 4 * 1024 * 1024;
+
+    static StreamBuffer& getInstance();
+
+    // Deleted for singleton
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+    size_t push(const void* data, size_t size, size_t alignment = 16);
+    GLuint getBuffer() const { return buffer; }
+
+    void endFrame();
+    void cleanup();
+
+    bool isPersistent() const { return persistent; }
+    const StreamStats& getLastStats() const { return lastStats; }
+
+private:
+    StreamBuffer() = default;
+
+    void create(size_t newPartitionSize);
+    void destroy();
+    void waitForPartition(int index);
+
+    GLuint buffer = 0;
+    unsigned char* mapped = nullptr;                // Whole buffer, when persistent
+    bool persistent = false;
+    size_t partitionSize = DEFAULT_PARTITION_SIZE;
+    int partition = 0;                              // Written this frame
+    size_t offset = 0;                              // Next free byte in the partition
+    GLsync fences[PARTITION_COUNT]{};
+
+    StreamStats stats;
+    StreamStats lastStats;
+};
@@ -3,17 +3,48 @@
 // Copyright (c) 2024, Ricky Zhang.
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
 #include "TextRenderer.h"
+#include "Buffers.h"
 #include "ObjectShader.h"
+#include "StreamBuffer.h"
 
 //#include "Utils.h"
 #include "ShaderPath.h"
 
+namespace {
+
+const std::vector<VertexAttribute> TEXT_VERTEX_LAYOUT = {
+    { 4, VertexComponent::FLOAT, false },           // {x, y} position, {u, v} texture coordinates
+    { 4, VertexComponent::UNSIGNED_BYTE, true }     // Color
+};
+
+/**
+* Next code point of a UTF-8 string. Malformed bytes come back as themselves, one at a time.
+*/
+uint32_t nextCodePoint(const std::string& text, size_t& i) {
+    unsigned char lead = static_cast<unsigned char>(text[i++]);
+    int extra = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+    if (extra == 0 || i + extra > text.size()) return lead;
+
+    uint32_t codePoint = lead & (0x3F >> extra);
+    for (int k = 0; k < extra; ++k) {
+        unsigned char next = static_cast<unsigned char>(text[i + k]);
+        if ((next & 0xC0) != 0x80) return lead;
+        codePoint = (codePoint << 6) | (next & 0x3F);
+    }
+    i += extra;
+    return codePoint;
+}
+
+}  // namespace
+
 /**
 * Constructor.
 */
@@ -27,20 +58,29 @@ TextRenderer::TextRenderer(const char* fontPath, unsigned int VAO, unsigned int
 
     if (FT_New_Face(ft, fontPath, 0, &face)) {
         std::cerr << "Failed to load font" << std::endl;
+        face = nullptr;
         return;
     }
 
-    FT_Set_Pixel_Sizes(face, 0, 48);
+    FT_Set_Pixel_Sizes(face, 0, FONT_PIXEL_SIZE);
 
     // Boilerplate text initialization
+    atlasPixels.assign(size_t(ATLAS_WIDTH) * atlasHeight, 0);
     glGenTextures(1, &textureID);
     glBindTexture(GL_TEXTURE_2D, textureID);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlasPixels.data());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 
     initRenderData();
+
+    // Printable ASCII covers almost everything drawn, so rasterise it now rather than mid-frame
+    for (uint32_t c = 32; c < 127; ++c) getGlyph(c);
+    glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 /**
@@ -48,7 +88,10 @@ TextRenderer::TextRenderer(const char* fontPath, unsigned int VAO, unsigned int
 */
 
 TextRenderer::~TextRenderer() {
-    FT_Done_Face(face);
+    glDeleteTextures(1, &textureID);
+    glDeleteBuffers(1, &VBO);
+    glDeleteVertexArrays(1, &VAO);
+    if (face) FT_Done_Face(face);
     FT_Done_FreeType(ft);
     delete shaderProgram;  // Clean up the shader program
 }
@@ -68,22 +111,9 @@ ShaderProgram* TextRenderer::getShaderProgram() {
 */
 
 void TextRenderer::initRenderData() {
+    // Vertices live in the StreamBuffer; flush() points the attributes at them
     glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-
-    // Allocate memory for 6 vertices with {x, y, z, w} coordinates. Dynamic draw = change frequently
-    glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
-
-    // Start at index 0
-    glEnableVertexAttribArray(0);
-
-    // Start at 0, 4 coords per attribute, float, don't normalize, byte offset, first component offset
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(GLfloat), nullptr);
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    VBO = 0;
 
 //    shaderProgram = new ShaderProgram("../assets/shaders/text.vs", "../assets/shaders/text.fs");
     shaderProgram = new ShaderProgram(TEXT_VERTEX_SHADER_PATH, TEXT_FRAGMENT_SHADER_PATH);
@@ -96,69 +126,169 @@ void TextRenderer::initRenderData() {
 }
 
 /**
-* Render text.
+* Find room for a glyph in the atlas, doubling its height (up to MAX_ATLAS_HEIGHT) if it is full.
+*
+* @param width                  [in] Glyph width in pixels.
+* @param height                 [in] Glyph height in pixels.
+* @param x                      [out] Left edge in the atlas.
+* @param y                      [out] Top edge in the atlas.
+*
+* @return false if the glyph cannot fit even in the largest atlas.
+*/
+
+bool TextRenderer::reserveAtlasSpace(int width, int height, int& x, int& y) {
+    if (width + GLYPH_PADDING > ATLAS_WIDTH) return false;
+
+    // Start a new shelf when this one is full
+    if (shelfX + width + GLYPH_PADDING > ATLAS_WIDTH) {
+        shelfY += shelfHeight + GLYPH_PADDING;
+        shelfX = 0;
+        shelfHeight = 0;
+    }
+
+    if (shelfY + height + GLYPH_PADDING > atlasHeight) {
+        int newHeight = atlasHeight;
+        while (shelfY + height + GLYPH_PADDING > newHeight) newHeight *= 2;
+        if (newHeight > MAX_ATLAS_HEIGHT) return false;
+
+        // Rows are stored top down, so growing only adds zeros at the end; glyph texel positions do not move
+        atlasHeight = newHeight;
+        atlasPixels.resize(size_t(ATLAS_WIDTH) * atlasHeight, 0);
+        glBindTexture(GL_TEXTURE_2D, textureID);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_WIDTH, atlasHeight, 0, GL_RED, GL_UNSIGNED_BYTE, atlasPixels.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    }
+
+    x = shelfX;
+    y = shelfY;
+    shelfX += width + GLYPH_PADDING;
+    shelfHeight = std::max(shelfHeight, height);
+    return true;
+}
+
+/**
+* Metrics and atlas position of a code point, rasterising it on first use. Glyphs that fail to load are cached as
+* blank so they are only reported once.
+*
+* @param codePoint              [in] Unicode code point.
+*/
+
+const TextRenderer::Glyph& TextRenderer::getGlyph(uint32_t codePoint) {
+    auto it = glyphs.find(codePoint);
+    if (it != glyphs.end()) return it->second;
+
+    Glyph& glyph = glyphs[codePoint];
+    if (face == nullptr || FT_Load_Char(face, codePoint, FT_LOAD_RENDER)) {
+        std::cerr << "Failed to load Glyph " << codePoint << std::endl;
+        return glyph;
+    }
+
+    const FT_Bitmap& bitmap = face->glyph->bitmap;
+    glyph.bearingX = face->glyph->bitmap_left;
+    glyph.bearingY = face->glyph->bitmap_top;
+    glyph.advance = float(face->glyph->advance.x >> 6);
+    if (bitmap.width == 0 || bitmap.rows == 0) return glyph;    // e.g. space
+
+    int width = int(bitmap.width), height = int(bitmap.rows);
+    if (!reserveAtlasSpace(width, height, glyph.x, glyph.y)) {
+        std::cerr << "Glyph atlas full, cannot add " << codePoint << std::endl;
+        return glyph;
+    }
+    glyph.width = width;
+    glyph.height = height;
+
+    for (int row = 0; row < height; ++row) {
+        memcpy(&atlasPixels[size_t(glyph.y + row) * ATLAS_WIDTH + glyph.x], bitmap.buffer + row * bitmap.pitch, width);
+    }
+    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, glyph.x, glyph.y, width, height, GL_RED, GL_UNSIGNED_BYTE, &atlasPixels[size_t(glyph.y) * ATLAS_WIDTH + glyph.x]);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return glyph;
+}
+
+/**
+* Queue text for the next flush().
 * 
-* @param text                   [in] The text to display.
+* @param text                   [in] The text to display, UTF-8.
 * 
-* @param x                      [in] X coordinate.
+* @param x                      [in] X coordinate of the baseline start.
 * 
-* @param y                      [in] Y coordinate.
+* @param y                      [in] Y coordinate of the baseline.
 * 
-* @param scale                  [in] Font size scale.
+* @param scale                  [in] Font size scale, relative to FONT_PIXEL_SIZE.
 * 
 * @param color                  [in] Color.
 */
 
-void TextRenderer::renderText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
-    shaderProgram->use();
-    shaderProgram->setVec3("textColor", color);
+void TextRenderer::addText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
+    uint32_t packedColor = packColor(color);
 
-    // TODO: Remove glActiveTexture and glBindVertexArray, since have moved to texture->use()
-    glActiveTexture(GL_TEXTURE0);
-    glBindVertexArray(VAO);
+    for (size_t i = 0; i < text.size();) {
+        const Glyph& glyph = getGlyph(nextCodePoint(text, i));
 
-    // Set pixel alignment to 1 byte
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        if (glyph.width > 0) {
+            GLfloat xpos = x + glyph.bearingX * scale;
+            GLfloat ypos = y - (glyph.height - glyph.bearingY) * scale;
 
-    std::string::const_iterator c;
-    for (c = text.begin(); c != text.end(); c++) {
-        if (FT_Load_Char(face, *c, FT_LOAD_RENDER)) {
-            std::cerr << "Failed to load Glyph" << std::endl;
-            continue;
-        }
+            GLfloat w = glyph.width * scale;
+            GLfloat h = glyph.height * scale;
 
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, face->glyph->bitmap.width, face->glyph->bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE, face->glyph->bitmap.buffer);
+            // In texels: the atlas may grow before flush(), so text.vs divides by its size at draw time.
+            // The atlas is uploaded top row first, so v grows downwards
+            GLfloat u0 = float(glyph.x);
+            GLfloat u1 = float(glyph.x + glyph.width);
+            GLfloat v0 = float(glyph.y);
+            GLfloat v1 = float(glyph.y + glyph.height);
 
-        GLfloat xpos = x + face->glyph->bitmap_left * scale;
-        GLfloat ypos = y - (face->glyph->bitmap.rows - face->glyph->bitmap_top) * scale;
+            TextVertex quad[6] = {
+                    { { xpos,     ypos + h }, { u0, v0 }, packedColor },
+                    { { xpos,     ypos     }, { u0, v1 }, packedColor },
+                    { { xpos + w, ypos     }, { u1, v1 }, packedColor },
 
-        GLfloat w = face->glyph->bitmap.width * scale;
-        GLfloat h = face->glyph->bitmap.rows * scale;
+                    { { xpos,     ypos + h }, { u0, v0 }, packedColor },
+                    { { xpos + w, ypos     }, { u1, v1 }, packedColor },
+                    { { xpos + w, ypos + h }, { u1, v0 }, packedColor }
+            };
+            vertices.insert(vertices.end(), quad, quad + 6);
+        }
 
-        GLfloat vertices[6][4] = {
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos,     ypos,       0.0f, 1.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
+        x += glyph.advance * scale;
+    }
+}
 
-                { xpos,     ypos + h,   0.0f, 0.0f },
-                { xpos + w, ypos,       1.0f, 1.0f },
-                { xpos + w, ypos + h,   1.0f, 0.0f }
-        };
+/**
+* Draw everything added since the last flush with one draw call.
+*/
 
-        glBindBuffer(GL_ARRAY_BUFFER, VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
+void TextRenderer::flush() {
+    if (vertices.empty()) return;
 
-        glDrawArrays(GL_TRIANGLES, 0, 6);
+    shaderProgram->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, textureID);
+
+    StreamBuffer& stream = StreamBuffer::getInstance();
+    size_t offset = stream.push(vertices.data(), vertices.size() * sizeof(TextVertex), sizeof(TextVertex));
+    glBindVertexArray(VAO);
+    bindVertexAttributes(stream.getBuffer(), offset, TEXT_VERTEX_LAYOUT, 0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    glDrawArrays(GL_TRIANGLES, 0, GLsizei(vertices.size()));
 
-        x += (face->glyph->advance.x >> 6) * scale;
-    }
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
+    vertices.clear();
+}
 
-    // Reset pixel alignment to default
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+/**
+* Render text now, with one draw call. To draw many strings, addText() each and flush() once instead.
+*/
+
+void TextRenderer::renderText(const std::string& text, float x, float y, float scale, const glm::vec3& color) {
+    addText(text, x, y, scale, color);
+    flush();
 }
 
 /**
@@ -5,6 +5,11 @@
 
 #pragma once
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 #include <glm/glm.hpp>
@@ -12,25 +17,64 @@
 
 class ShaderProgram;
 
+/**
+* Screen space text from one FreeType face.
+*
+* Glyphs are rasterised once into a single-channel atlas texture, the printable ASCII range up front and anything
+* else the first time it is drawn. addText() only appends quads to a vertex array, and flush() draws everything
+* added since the last flush with one upload and one draw call, so a whole HUD costs about as much as one string.
+*/
 class TextRenderer {
 public:
     // Needs a path to .ttf font file, and VAO and VBO for rendering text
     TextRenderer(const char* fontPath, unsigned int VAO, unsigned int VBO);
     ~TextRenderer();
 
+    void addText(const std::string& text, float x, float y, float scale, const glm::vec3& color);
+    void flush();
     void renderText(const std::string& text, float x, float y, float scale, const glm::vec3& color);
     ShaderProgram* getShaderProgram();
 
     void resize(int width, int height);
 
 private:
+    // Where a glyph is in the atlas, in pixels, and how to place it
+    struct Glyph {
+        int x = 0, y = 0;
+        int width = 0, height = 0;
+        int bearingX = 0, bearingY = 0;
+        float advance = 0.0f;
+    };
+
+    // Position and texture coordinates, then RGBA8 color
+    struct TextVertex {
+        float position[2];
+        float texCoord[2];
+        uint32_t color;
+    };
+
+    static constexpr int FONT_PIXEL_SIZE = 48;
+    static constexpr int ATLAS_WIDTH = 1024;
+    static constexpr int MAX_ATLAS_HEIGHT = 4096;
+    static constexpr int GLYPH_PADDING = 1;             // Keeps linear filtering from bleeding between glyphs
+
     FT_Library ft{};   // Must load FreeType library
     FT_Face face{};    // Contains font data/glyphs
     GLuint textureID{};
     GLuint VAO, VBO;
 
+    // Atlas, with a CPU copy so it can grow without re-rasterising
+    std::unordered_map<uint32_t, Glyph> glyphs;
+    std::vector<unsigned char> atlasPixels;
+    int atlasHeight = 256;
+    int shelfX = 0, shelfY = 0, shelfHeight = 0;       // Next free spot, packed in rows ("shelves")
+
+    std::vector<TextVertex> vertices;                   // Added since the last flush
+
     // Shader program for rendering text: contains the vertex and fragment shaders
     ShaderProgram* shaderProgram{};
 
     void initRenderData();
+    const Glyph& getGlyph(uint32_t codePoint);
+    bool reserveAtlasSpace(int width, int height, int& x, int& y);
 };
@@ -7,6 +7,7 @@
 #include <stb_image.h>
 
 #include "Texture.h"
+#include "TextureCache.h"
 
 /**
 * Constructor.
@@ -28,27 +29,57 @@ Texture::Texture(const char* imagePath) : path(imagePath) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    // Load image data
-    int w, h, nrChannels;
-
-//    stbi_set_flip_vertically_on_load(true);  // Flip image vertically
-
-    unsigned char* data = stbi_load(imagePath, &w, &h, &nrChannels, 0);
-    width = w;
-    height = h;
-    if (data) {
-        GLenum format = (nrChannels == 4) ? GL_RGBA : GL_RGB;
-        glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data);
-        glGenerateMipmap(GL_TEXTURE_2D);  // Generate mipmaps for the texture
-        std::cout << "Loaded texture: " << imagePath << " with dimensions: " << w << "x" << h << " and channels: " << nrChannels << std::endl;
-    } else {
-        std::cout << "Failed to load texture: " << imagePath << std::endl;
-        std::cerr << "Reason: " << stbi_failure_reason() << std::endl;
+    // Load image data, with its mipmaps, from the baked cache (decoded and baked on first use)
+    TextureImage image;
+    if (TextureCache::load(imagePath, image)) {
+        width = image.width;
+        height = image.height;
+        GLenum format = (image.channels == 4) ? GL_RGBA : GL_RGB;
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);  // RGB rows are not always a multiple of 4 bytes
+        for (size_t level = 0; level < image.levels.size(); ++level) {
+            const TextureLevel& mip = image.levels[level];
+            glTexImage2D(GL_TEXTURE_2D, GLint(level), format, mip.width, mip.height, 0, format, GL_UNSIGNED_BYTE, mip.data);
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, GLint(image.levels.size()) - 1);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        std::cout << "Loaded texture: " << imagePath << " with dimensions: " << width << "x" << height << " and channels: " << image.channels << std::endl;
     }
-    stbi_image_free(data);
     glBindTexture(GL_TEXTURE_2D, 0); // Unbind texture when done to prevent accidental modification
 }
 
+/**
+* Constructor for a texture decoded in the background. Until setImage() is called this draws as the placeholder,
+* whose GL texture it borrows.
+*
+* @param imagePath              [in] Image file, for the loader.
+* @param placeholder            [in] Already loaded texture to show meanwhile. Must outlive this texture.
+*/
+
+Texture::Texture(const char* imagePath, const Texture& placeholder) : path(imagePath) {
+    ID = placeholder.ID;
+    width = placeholder.width;
+    height = placeholder.height;
+    loaded = false;
+    ownsID = false;
+}
+
+/**
+* Take ownership of the uploaded image, replacing the placeholder.
+*
+* @param textureID              [in] Complete GL texture, mipmaps included.
+* @param imageWidth             [in] Width in pixels.
+* @param imageHeight            [in] Height in pixels.
+*/
+
+void Texture::setImage(GLuint textureID, unsigned int imageWidth, unsigned int imageHeight) {
+    cleanup();
+    ID = textureID;
+    width = imageWidth;
+    height = imageHeight;
+    loaded = true;
+    ownsID = true;
+}
+
 /**
 * Enable texture use.
 */
@@ -64,8 +95,8 @@ void Texture::use(int textureUnit) const {
 */
 
 void Texture::cleanup() {
-    if (ID != 0) {
+    if (ID != 0 && ownsID) {
         glDeleteTextures(1, &ID);
-        ID = 0;
     }
+    ID = 0;
 }
@@ -19,11 +19,20 @@ public:
 
     // Constructor for loading and creating a texture
     Texture(const char* imagePath);
+    // Shows placeholder until a TextureLoader calls setImage()
+    Texture(const char* imagePath, const Texture& placeholder);
     ~Texture() {
         cleanup();
     }
     void cleanup();
 
+    bool isLoaded() const { return loaded; }
+    void setImage(GLuint textureID, unsigned int imageWidth, unsigned int imageHeight);
+
     // Method to bind the texture before drawing
     void use(int textureUnit = 0) const;
+
+private:
+    bool loaded = true;
+    bool ownsID = true;         // false while ID is the placeholder's
 };
\ No newline at end of file
@@ -0,0 +1,363 @@
+////////////////////////////////////////////////////////////////////////////////
+// TextureCache.cpp -- Binary .bbtex baked texture cache -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+// Layout, little endian:
+//   header: TextureCacheHeader
+//   levels: { u64 offset u32 storedSize u32 rawSize }*levelCount
+//   then each level's pixels (zlib data if TEXTURE_CACHE_ZLIB), starting on a 4 byte boundary
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+#include <stb_image.h>
+#include <zlib.h>
+
+#include "TextureCache.h"
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct TextureCacheHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t sourceHash;        // FNV-1a of the image file contents
+    uint64_t sourceStamp;       // FNV-1a of its size and modification time, checked before the hash
+    uint32_t width;
+    uint32_t height;
+    uint32_t channels;
+    uint32_t levelCount;
+    uint32_t flags;
+    uint32_t reserved;
+};
+
+struct TextureCacheLevel {
+    uint64_t offset;            // From the start of the file
+    uint32_t storedSize;        // Bytes in the file
+    uint32_t rawSize;           // Bytes once inflated
+};
+
+constexpr char TEXTURE_CACHE_MAGIC[4] = { 'B', 'B', 'T', 'X' };
+constexpr uint32_t TEXTURE_CACHE_ZLIB = 1;
+constexpr uint64_t FNV_OFFSET = 1469598103934665603ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+// Loader workers can bake the same image at once, so each write gets its own temporary file
+std::atomic<uint32_t> tempFileCounter{ 0 };
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+size_t padTo4(size_t size) {
+    return (size + 3) & ~size_t(3);
+}
+
+bool computeStamp(const fs::path& path, uint64_t& stamp) {
+    error_code ec;
+    uint64_t size = fs::file_size(path, ec);
+    if (ec) return false;
+    int64_t time = fs::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) return false;
+    stamp = fnv1a(FNV_OFFSET, &size, sizeof(size));
+    stamp = fnv1a(stamp, &time, sizeof(time));
+    return true;
+}
+
+bool computeHash(const fs::path& path, uint64_t& hash) {
+    hash = FNV_OFFSET;
+    vector<char> buffer(1 << 16);
+    ifstream file(path, ios::binary);
+    if (!file) return false;
+    while (file) {
+        file.read(buffer.data(), buffer.size());
+        hash = fnv1a(hash, buffer.data(), size_t(file.gcount()));
+    }
+    return true;
+}
+
+size_t levelSize(int width, int height, int channels) {
+    return size_t(width) * height * channels;
+}
+
+// Sizes of every level down to 1x1, as glGenerateMipmap would make them
+vector<pair<int, int>> mipSizes(int width, int height) {
+    vector<pair<int, int>> sizes = { { width, height } };
+    while (width > 1 || height > 1) {
+        width = std::max(width / 2, 1);
+        height = std::max(height / 2, 1);
+        sizes.push_back({ width, height });
+    }
+    return sizes;
+}
+
+/**
+* 2x2 box filter. Odd edges reuse the last row or column.
+*/
+void downsample(const TextureLevel& source, TextureLevel& target, int channels) {
+    unsigned char* out = const_cast<unsigned char*>(target.data);
+    for (int y = 0; y < target.height; ++y) {
+        int y0 = std::min(y * 2, source.height - 1), y1 = std::min(y * 2 + 1, source.height - 1);
+        for (int x = 0; x < target.width; ++x) {
+            int x0 = std::min(x * 2, source.width - 1), x1 = std::min(x * 2 + 1, source.width - 1);
+            for (int c = 0; c < channels; ++c) {
+                int sum = source.data[(size_t(y0) * source.width + x0) * channels + c]
+                    + source.data[(size_t(y0) * source.width + x1) * channels + c]
+                    + source.data[(size_t(y1) * source.width + x0) * channels + c]
+                    + source.data[(size_t(y1) * source.width + x1) * channels + c];
+                *out++ = (unsigned char)((sum + 2) / 4);
+            }
+        }
+    }
+}
+
+/**
+* Size storage for every level and point the levels into it.
+*/
+void allocateLevels(TextureImage& image, const vector<pair<int, int>>& sizes) {
+    size_t total = 0;
+    for (const auto& [w, h] : sizes) total += levelSize(w, h, image.channels);
+    image.storage.resize(total);
+
+    image.levels.clear();
+    size_t offset = 0;
+    for (const auto& [w, h] : sizes) {
+        image.levels.push_back({ image.storage.data() + offset, w, h });
+        offset += levelSize(w, h, image.channels);
+    }
+}
+
+}  // namespace
+
+/**
+* Where the cache for an image lives: next to it, with .bbtex appended so wood.jpg and wood.png do not collide.
+*/
+
+string TextureCache::getCachePath(const string& imagePath) {
+    return imagePath + ".bbtex";
+}
+
+/**
+* Get an image's mip chain from its cache, baking and writing the cache first if it is missing or stale. Safe to
+* call from any thread.
+*
+* @param imagePath              [in] Source JPEG/PNG.
+* @param image                  [out] The mip chain.
+*
+* @return false if neither the cache nor the source can be read.
+*/
+
+bool TextureCache::load(const string& imagePath, TextureImage& image) {
+    if (read(imagePath, image)) return true;
+    if (!bake(imagePath, image)) return false;
+
+    if (!write(imagePath, image)) {
+        cerr << "Warning: Could not write texture cache " << getCachePath(imagePath) << endl;
+    }
+    return true;
+}
+
+/**
+* Map the cache for an image if it exists and matches the current source.
+*
+* @param imagePath              [in] Source JPEG/PNG.
+* @param image                  [out] The mip chain. Uncompressed levels point into the mapped file.
+*
+* @return true if image can be used.
+*/
+
+bool TextureCache::read(const string& imagePath, TextureImage& image) {
+    image = TextureImage();
+    image.file = make_unique<MappedFile>();
+    if (!image.file->open(getCachePath(imagePath))) {
+        image = TextureImage();
+        return false;
+    }
+    const unsigned char* data = image.file->getData();
+    size_t size = image.file->getSize();
+
+    TextureCacheHeader header;
+    bool valid = size >= sizeof(header);
+    if (valid) {
+        memcpy(&header, data, sizeof(header));
+        valid = memcmp(header.magic, TEXTURE_CACHE_MAGIC, sizeof(header.magic)) == 0 && header.version == VERSION
+            && (header.channels == 3 || header.channels == 4) && header.width > 0 && header.height > 0
+            && sizeof(header) + size_t(header.levelCount) * sizeof(TextureCacheLevel) <= size;
+    }
+
+    // Unchanged size and time are trusted; otherwise the contents decide
+    if (valid) {
+        uint64_t stamp, hash;
+        if (!computeStamp(imagePath, stamp)) valid = false;
+        else if (stamp != header.sourceStamp) valid = computeHash(imagePath, hash) && hash == header.sourceHash;
+    }
+
+    vector<pair<int, int>> sizes;
+    vector<TextureCacheLevel> entries;
+    if (valid) {
+        image.width = int(header.width);
+        image.height = int(header.height);
+        image.channels = int(header.channels);
+        sizes = mipSizes(image.width, image.height);
+        entries.resize(header.levelCount);
+        memcpy(entries.data(), data + sizeof(header), entries.size() * sizeof(TextureCacheLevel));
+        valid = entries.size() == sizes.size();
+    }
+    for (size_t i = 0; valid && i < entries.size(); ++i) {
+        valid = entries[i].rawSize == levelSize(sizes[i].first, sizes[i].second, image.channels)
+            && entries[i].offset <= size && entries[i].storedSize <= size - entries[i].offset;
+    }
+    if (!valid) {
+        image = TextureImage();
+        return false;
+    }
+
+    if (header.flags & TEXTURE_CACHE_ZLIB) {
+        allocateLevels(image, sizes);
+        for (size_t i = 0; valid && i < entries.size(); ++i) {
+            uLongf rawSize = entries[i].rawSize;
+            valid = uncompress(const_cast<unsigned char*>(image.levels[i].data), &rawSize, data + entries[i].offset,
+                uLong(entries[i].storedSize)) == Z_OK && rawSize == entries[i].rawSize;
+        }
+        image.file.reset();
+    }
+    else {
+        // Used in place; the mapping stays open for as long as the image lives
+        for (size_t i = 0; valid && i < entries.size(); ++i) {
+            valid = entries[i].storedSize == entries[i].rawSize;
+            image.levels.push_back({ data + entries[i].offset, sizes[i].first, sizes[i].second });
+        }
+    }
+
+    if (!valid) {
+        image = TextureImage();
+        return false;
+    }
+    return true;
+}
+
+/**
+* Write the cache for an image. Written to a temporary file and renamed, so a crash never leaves a torn cache.
+*
+* @param imagePath              [in] Source JPEG/PNG the image came from.
+* @param image                  [in] Full mip chain.
+* @param compress               [in] zlib compress each level.
+*
+* @return false if the source cannot be read or the cache cannot be written (e.g. a read-only install).
+*/
+
+bool TextureCache::write(const string& imagePath, const TextureImage& image, bool compress) {
+    TextureCacheHeader header{};
+    memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(header.magic));
+    header.version = VERSION;
+    if (!computeStamp(imagePath, header.sourceStamp) || !computeHash(imagePath, header.sourceHash)) return false;
+    header.width = uint32_t(image.width);
+    header.height = uint32_t(image.height);
+    header.channels = uint32_t(image.channels);
+    header.levelCount = uint32_t(image.levels.size());
+    header.flags = compress ? TEXTURE_CACHE_ZLIB : 0;
+
+    // Level data as stored, then the table that points at it
+    vector<vector<unsigned char>> compressed(compress ? image.levels.size() : 0);
+    vector<TextureCacheLevel> entries(image.levels.size());
+    uint64_t offset = sizeof(header) + entries.size() * sizeof(TextureCacheLevel);
+    for (size_t i = 0; i < image.levels.size(); ++i) {
+        const TextureLevel& level = image.levels[i];
+        size_t rawSize = levelSize(level.width, level.height, image.channels);
+        size_t storedSize = rawSize;
+        if (compress) {
+            uLongf compressedSize = compressBound(uLong(rawSize));
+            compressed[i].resize(compressedSize);
+            if (compress2(compressed[i].data(), &compressedSize, level.data, uLong(rawSize), Z_DEFAULT_COMPRESSION) != Z_OK) {
+                return false;
+            }
+            compressed[i].resize(compressedSize);
+            storedSize = compressedSize;
+        }
+        entries[i] = { padTo4(offset), uint32_t(storedSize), uint32_t(rawSize) };
+        offset = entries[i].offset + storedSize;
+    }
+
+    string cachePath = getCachePath(imagePath);
+    string tempPath = cachePath + "." + to_string(++tempFileCounter) + ".tmp";
+    {
+        ofstream out(tempPath, ios::binary | ios::trunc);
+        if (!out) return false;
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(TextureCacheLevel));
+        uint64_t written = sizeof(header) + entries.size() * sizeof(TextureCacheLevel);
+        for (size_t i = 0; i < entries.size(); ++i) {
+            static const char zeros[4] = {};
+            out.write(zeros, entries[i].offset - written);
+            const unsigned char* bytes = compress ? compressed[i].data() : image.levels[i].data;
+            out.write(reinterpret_cast<const char*>(bytes), entries[i].storedSize);
+            written = entries[i].offset + entries[i].storedSize;
+        }
+
+        if (!out) {
+            out.close();
+            remove(tempPath.c_str());
+            return false;
+        }
+    }
+
+    error_code ec;
+    fs::rename(tempPath, cachePath, ec);
+    if (ec) {
+        remove(tempPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+/**
+* Decode a source image and build its mip chain on the CPU.
+*
+* @param imagePath              [in] Source JPEG/PNG.
+* @param image                  [out] Full mip chain in image.storage.
+*
+* @return false if the image cannot be decoded.
+*/
+
+bool TextureCache::bake(const string& imagePath, TextureImage& image) {
+    image = TextureImage();
+
+    // Grey and grey-alpha images are expanded so textures only deal with RGB and RGBA
+    int w, h, n;
+    unsigned char* pixels = nullptr;
+    if (stbi_info(imagePath.c_str(), &w, &h, &n)) {
+        image.channels = (n == 2 || n == 4) ? 4 : 3;
+        pixels = stbi_load(imagePath.c_str(), &w, &h, &n, image.channels);
+    }
+    if (pixels == nullptr) {
+        std::cout << "Failed to load texture: " << imagePath << std::endl;
+        std::cerr << "Reason: " << stbi_failure_reason() << std::endl;
+        image = TextureImage();
+        return false;
+    }
+    image.width = w;
+    image.height = h;
+
+    allocateLevels(image, mipSizes(w, h));
+    memcpy(image.storage.data(), pixels, levelSize(w, h, image.channels));
+    stbi_image_free(pixels);
+
+    for (size_t i = 1; i < image.levels.size(); ++i) {
+        downsample(image.levels[i - 1], image.levels[i], image.channels);
+    }
+    return true;
+}
@@ -0,0 +1,54 @@
+////////////////////////////////////////////////////////////////////////////////
+// TextureCache.h -- Binary .bbtex baked texture cache include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+/**
+* One mip level, tightly packed rows of TextureImage::channels bytes per pixel.
+*/
+struct TextureLevel {
+    const unsigned char* data = nullptr;
+    int width = 0, height = 0;
+};
+
+/**
+* A texture with its whole mip chain, ready for glTexImage2D. The level pointers point either into storage or into
+* the mapped cache file, so they stay valid when the image is moved but not after it is destroyed.
+*/
+struct TextureImage {
+    int width = 0, height = 0;
+    int channels = 0;                           // 3 or 4
+    std::vector<TextureLevel> levels;           // Level 0 first
+
+    std::vector<unsigned char> storage;         // Decoded, baked or inflated here
+    std::unique_ptr<MappedFile> file;           // Read in place from an uncompressed cache
+};
+
+/**
+* A .bbtex file stored next to a source image (wood.jpg -> wood.jpg.bbtex), holding the RGB or RGBA mip chain so
+* loading is a map of the file and one upload per level, with no JPEG/PNG decode and no glGenerateMipmap.
+*
+* Like MeshCache, the cache records the source's size and modification time plus a hash of its contents, and is
+* rebuilt when the contents change. Levels may be zlib compressed, trading a fast inflate for a smaller file.
+* Bump VERSION whenever the layout or the mip filter changes.
+*/
+class TextureCache {
+public:
+    static constexpr uint32_t VERSION = 1;
+
+    static std::string getCachePath(const std::string& imagePath);
+
+    static bool load(const std::string& imagePath, TextureImage& image);
+    static bool read(const std::string& imagePath, TextureImage& image);
+    static bool write(const std::string& imagePath, const TextureImage& image, bool compress = false);
+    static bool bake(const std::string& imagePath, TextureImage& image);
+};
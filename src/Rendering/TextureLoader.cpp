@@ -0,0 +1,204 @@
+////////////////////////////////////////////////////////////////////////////////
+// TextureLoader.cpp -- Background texture loading and upload -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include "TextureLoader.h"
+
+#include "Texture.h"
+#include "Utils.h"
+
+using namespace std;
+
+/**
+* Constructor. Workers are started by the first load().
+*
+* @param workerCount            [in] Loading threads.
+*/
+
+TextureLoader::TextureLoader(unsigned workerCount) : workerCount(std::max(workerCount, 1u)) {
+}
+
+TextureLoader::~TextureLoader() {
+    stop();
+}
+
+void TextureLoader::startWorkers() {
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&TextureLoader::workerLoop, this);
+    }
+}
+
+/**
+* Queue a texture for loading. It keeps its placeholder until update() finishes its upload; if the texture is
+* released first the work is dropped.
+*
+* @param texture                [in] Texture created with a placeholder, its path names the image file.
+*/
+
+void TextureLoader::load(const shared_ptr<Texture>& texture) {
+    if (workers.empty()) startWorkers();
+
+    Image request;
+    request.texture = texture;
+    request.path = texture->path;
+    {
+        lock_guard<std::mutex> lock(mutex);
+        requests.push_back(std::move(request));
+    }
+    condition.notify_one();
+}
+
+/**
+* Worker thread: read (or bake) requested images until stop().
+*/
+
+void TextureLoader::workerLoop() {
+    while (true) {
+        Image image;
+        {
+            unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !requests.empty(); });
+            if (stopping) return;
+            image = std::move(requests.front());
+            requests.pop_front();
+            ++decodingCount;
+        }
+
+        bool loaded = TextureCache::load(image.path, image.data);
+
+        lock_guard<std::mutex> lock(mutex);
+        --decodingCount;
+        if (loaded) decoded.push_back(std::move(image));
+    }
+}
+
+/**
+* Upload loaded images, oldest first and level by level, until byteBudget bytes have gone through the pixel buffer.
+* Call once per frame from the GL thread. The buffer is orphaned for every slice, so a slice never waits for the
+* previous one to be consumed.
+*
+* @param byteBudget             [in] Pixel bytes to upload this call. At least one row is always uploaded.
+*/
+
+void TextureLoader::update(size_t byteBudget) {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        while (!decoded.empty()) {
+            uploads.push_back({ std::move(decoded.front()) });
+            decoded.pop_front();
+        }
+    }
+    if (uploads.empty()) return;
+
+    if (pixelBuffer == 0) glGenBuffers(1, &pixelBuffer);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);      // RGB rows are not always a multiple of 4 bytes
+
+    size_t spent = 0;
+    while (!uploads.empty() && spent < byteBudget) {
+        Upload& upload = uploads.front();
+        const TextureImage& image = upload.image.data;
+
+        shared_ptr<Texture> texture = upload.image.texture.lock();
+        if (!texture) {
+            glDeleteTextures(1, &upload.textureID);
+            uploads.pop_front();
+            continue;
+        }
+
+        // Every level is allocated up front, so the texture is complete as soon as the last row lands. No pixel
+        // buffer may be bound here, or the nullptr data would be read as an offset into it.
+        GLenum format = (image.channels == 4) ? GL_RGBA : GL_RGB;
+        if (upload.textureID == 0) {
+            glGenTextures(1, &upload.textureID);
+            glBindTexture(GL_TEXTURE_2D, upload.textureID);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, GLint(image.levels.size()) - 1);
+            for (size_t level = 0; level < image.levels.size(); ++level) {
+                const TextureLevel& mip = image.levels[level];
+                glTexImage2D(GL_TEXTURE_2D, GLint(level), format, mip.width, mip.height, 0, format, GL_UNSIGNED_BYTE, nullptr);
+            }
+        }
+        else {
+            glBindTexture(GL_TEXTURE_2D, upload.textureID);
+        }
+
+        const TextureLevel& mip = image.levels[upload.level];
+        size_t rowBytes = size_t(mip.width) * image.channels;
+        int rows = int(std::min<size_t>(std::max<size_t>((byteBudget - spent) / rowBytes, 1), mip.height - upload.nextRow));
+        size_t bytes = rows * rowBytes;
+
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffer);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+        void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        if (mapped == nullptr) {
+            std::cerr << "Failed to map pixel buffer for: " << upload.image.path << std::endl;
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            glDeleteTextures(1, &upload.textureID);
+            uploads.pop_front();
+            continue;
+        }
+        memcpy(mapped, mip.data + upload.nextRow * rowBytes, bytes);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+        // Reads from offset 0 of the bound pixel buffer
+        glTexSubImage2D(GL_TEXTURE_2D, GLint(upload.level), 0, upload.nextRow, mip.width, rows, format, GL_UNSIGNED_BYTE, nullptr);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        upload.nextRow += rows;
+        spent += bytes;
+
+        if (upload.nextRow < mip.height) continue;
+        upload.nextRow = 0;
+        if (++upload.level < image.levels.size()) continue;
+
+        texture->setImage(upload.textureID, image.width, image.height);
+        std::cout << "Loaded texture: " << upload.image.path << " with dimensions: " << image.width << "x" << image.height
+            << " and channels: " << image.channels << std::endl;
+        uploads.pop_front();
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    GL_CHECK("TextureLoader");
+}
+
+/**
+* Stop the workers and drop everything not yet uploaded; the affected textures keep their placeholder. Must be
+* called on the GL thread while the context is current, unless nothing was ever uploaded. load() may be used again
+* afterwards.
+*/
+
+void TextureLoader::stop() {
+    {
+        lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (std::thread& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    workers.clear();
+
+    decoded.clear();
+    requests.clear();
+    stopping = false;
+
+    for (Upload& upload : uploads) glDeleteTextures(1, &upload.textureID);
+    uploads.clear();
+    if (pixelBuffer != 0) {
+        glDeleteBuffers(1, &pixelBuffer);
+        pixelBuffer = 0;
+    }
+}
+
+size_t TextureLoader::getPendingCount() const {
+    lock_guard<std::mutex> lock(mutex);
+    return requests.size() + decodingCount + decoded.size() + uploads.size();
+}
@@ -0,0 +1,73 @@
+////////////////////////////////////////////////////////////////////////////////
+// TextureLoader.h -- Background texture loading and upload include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "TextureCache.h"
+
+class Texture;
+
+/**
+* Reads baked mip chains (see TextureCache) on worker threads and uploads them on the GL thread through a pixel
+* buffer object, a few rows at a time, so no frame waits on a whole file read or a whole image upload. Textures
+* handed to load() keep drawing their placeholder until update() has uploaded the last row of the last level.
+*/
+class TextureLoader {
+public:
+    static constexpr size_t UPLOAD_BUDGET = 4 * 1024 * 1024;       // Bytes per update(), i.e. per frame
+
+    TextureLoader(unsigned workerCount = 2);
+    ~TextureLoader();
+
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    void load(const std::shared_ptr<Texture>& texture);
+    void update(size_t byteBudget = UPLOAD_BUDGET);
+    void stop();
+
+    size_t getPendingCount() const;     // GL thread only
+
+private:
+    struct Image {
+        std::weak_ptr<Texture> texture;
+        std::string path;
+        TextureImage data;                          // Empty until a worker has loaded it
+    };
+
+    // Image being copied into its GL texture (GL thread only)
+    struct Upload {
+        Image image;
+        GLuint textureID = 0;
+        size_t level = 0;
+        int nextRow = 0;
+    };
+
+    void workerLoop();
+    void startWorkers();
+
+    unsigned workerCount;
+    std::vector<std::thread> workers;
+
+    mutable std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Image> requests;                     // Waiting for a worker, no pixels yet
+    std::deque<Image> decoded;                      // Waiting for the GL thread
+    size_t decodingCount = 0;
+    bool stopping = false;
+
+    std::deque<Upload> uploads;
+    GLuint pixelBuffer = 0;
+};
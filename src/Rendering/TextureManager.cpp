@@ -1,5 +1,6 @@
 #include "TextureManager.h"
 #include "Texture.h"
+#include "DefaultValues.h"
 
 // Singleton access - ensures only one instance of TextureManager
 TextureManager& TextureManager::getInstance() {
@@ -16,7 +17,8 @@ std::shared_ptr<Texture> TextureManager::loadTexture(const std::string& name, co
     if (it != textures.end()) {
         return it->second;
     }
-    std::shared_ptr<Texture> texture = std::make_shared<Texture>(filePath.c_str());
+    std::shared_ptr<Texture> texture = std::make_shared<Texture>(filePath.c_str(), *DefaultTexture());
+    loader.load(texture);
 
     textures[name] = texture;
     return texture;
@@ -38,8 +40,9 @@ void TextureManager::unloadTexture(const std::string& name) {
     textures.erase(name);
 }
 
-// Clears all loaded textures
+// Clears all loaded textures, dropping any still loading. Call with the GL context current
 void TextureManager::clear() {
     std::lock_guard<std::mutex> lock(mutex);
+    loader.stop();
     textures.clear();
 }
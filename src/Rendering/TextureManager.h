@@ -7,6 +7,7 @@
 
 // Since Textures should ALWAYS be interacted with through TextureManager
 #include "Texture.h"
+#include "TextureLoader.h"
 
 // Manages string->Texture* map
 class TextureManager {
@@ -17,13 +18,19 @@ public:
     TextureManager(const TextureManager&) = delete;
     TextureManager& operator=(const TextureManager&) = delete;
 
+    // Returns at once; the texture shows DefaultTexture() until update() has uploaded it
     std::shared_ptr<Texture> loadTexture(const std::string& name, const std::string& texturePath);
     std::shared_ptr<Texture> getTexture(const std::string& texturePath) const;
 
+    // Once per frame on the GL thread
+    void update() { loader.update(); }
+    size_t getPendingCount() const { return loader.getPendingCount(); }
+
     void unloadTexture(const std::string& name);
     void clear();
 private:
     TextureManager() = default;
     mutable std::mutex mutex;
     std::unordered_map<std::string, std::shared_ptr<Texture>> textures;
+    TextureLoader loader;
 };
\ No newline at end of file
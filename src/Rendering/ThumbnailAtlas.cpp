@@ -0,0 +1,151 @@
+////////////////////////////////////////////////////////////////////////////////
+// ThumbnailAtlas.cpp -- Cached object thumbnails -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+
+#include "ThumbnailAtlas.h"
+
+#include "Utils.h"
+
+using namespace std;
+
+ContentHash& ContentHash::addBytes(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+    return *this;
+}
+
+ThumbnailAtlas::ThumbnailAtlas() {
+    int size = CELL_SIZE * COLUMNS;
+
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, size, size, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, size, size);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "ThumbnailAtlas: framebuffer is not complete" << std::endl;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    // Handed out from the back, so cell 0 (top left) goes first
+    for (int i = COLUMNS * COLUMNS - 1; i >= 0; --i) freeCells.push_back(i);
+}
+
+ThumbnailAtlas::~ThumbnailAtlas() {
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &texture);
+    glDeleteRenderbuffers(1, &depthBuffer);
+}
+
+/**
+* Start a new frame's render budget. Call once per frame before any get().
+*/
+
+void ThumbnailAtlas::beginFrame() {
+    ++frame;
+    lastRenderCount = renderCount;
+    renderCount = 0;
+}
+
+/**
+* Look up a thumbnail, rendering it if it is missing and this frame's budget allows.
+*
+* @param key                    [in] Content hash of the object, see ContentHash.
+* @param render                 [in] Draws the object. Only called on a miss.
+* @param uv0                    [out] Top left texture coordinate of the cell, as ImGui::Image expects.
+* @param uv1                    [out] Bottom right texture coordinate of the cell.
+*
+* @return false if the thumbnail is not ready yet; ask again next frame.
+*/
+
+bool ThumbnailAtlas::get(uint64_t key, const RenderFunction& render, glm::vec2& uv0, glm::vec2& uv1) {
+    auto it = cells.find(key);
+    if (it == cells.end()) {
+        if (renderCount >= RENDERS_PER_FRAME) return false;
+
+        int index = findFreeCell();
+        if (index < 0) return false;        // Every cell is on screen this frame
+
+        renderCell(index, render);
+        ++renderCount;
+        it = cells.emplace(key, Cell{ index, frame }).first;
+    }
+    it->second.lastUsed = frame;
+
+    // Rows count up from the bottom of the texture, so the image is flipped
+    int index = it->second.index;
+    float step = 1.0f / COLUMNS;
+    float u = float(index % COLUMNS) * step;
+    float v = float(index / COLUMNS) * step;
+    uv0 = glm::vec2(u, v + step);
+    uv1 = glm::vec2(u + step, v);
+    return true;
+}
+
+/**
+* A free cell, or the least recently used one if none is free. Cells used this frame are never evicted.
+*
+* @return Cell index, or -1 if there is none.
+*/
+
+int ThumbnailAtlas::findFreeCell() {
+    if (!freeCells.empty()) {
+        int index = freeCells.back();
+        freeCells.pop_back();
+        return index;
+    }
+
+    auto oldest = cells.end();
+    for (auto it = cells.begin(); it != cells.end(); ++it) {
+        if (oldest == cells.end() || it->second.lastUsed < oldest->second.lastUsed) oldest = it;
+    }
+    if (oldest == cells.end() || oldest->second.lastUsed == frame) return -1;
+
+    int index = oldest->second.index;
+    cells.erase(oldest);
+    return index;
+}
+
+void ThumbnailAtlas::renderCell(int index, const RenderFunction& render) {
+    GLint previousFramebuffer, previousViewport[4];
+    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    glGetIntegerv(GL_VIEWPORT, previousViewport);
+
+    int x = (index % COLUMNS) * CELL_SIZE;
+    int y = (index / COLUMNS) * CELL_SIZE;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(x, y, CELL_SIZE, CELL_SIZE);
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(x, y, CELL_SIZE, CELL_SIZE);
+    glEnable(GL_DEPTH_TEST);
+    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    render();
+
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_FRAMEBUFFER, previousFramebuffer);
+    glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    GL_CHECK("ThumbnailAtlas");
+}
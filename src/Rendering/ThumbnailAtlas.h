@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// ThumbnailAtlas.h -- Cached object thumbnails include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+/**
+* FNV-1a hash of everything that changes how an object looks, used as its thumbnail key. Only add values without
+* padding bytes: scalars, glm vectors, strings.
+*/
+class ContentHash {
+public:
+    template <typename T>
+    ContentHash& add(const T& value) { return addBytes(&value, sizeof(T)); }
+    ContentHash& add(const std::string& value) { return addBytes(value.data(), value.size()).add(value.size()); }
+
+    uint64_t get() const { return hash; }
+
+private:
+    ContentHash& addBytes(const void* data, size_t size);
+
+    uint64_t hash = 0xcbf29ce484222325ull;
+};
+
+/**
+* Small renders of beyblades and stadiums for selection lists, packed in one texture so a list of 60 entries costs
+* one texture and no per-frame rendering. A cell is rendered once per content key and reused until it is the least
+* recently used one and its space is needed; editing an object changes its key, so stale cells simply age out.
+*
+* At most RENDERS_PER_FRAME cells are rendered per frame, so opening a long list spreads the work over a few frames
+* and get() returns false for the entries still waiting.
+*/
+class ThumbnailAtlas {
+public:
+    static constexpr int CELL_SIZE = 128;
+    static constexpr int COLUMNS = 8;                   // COLUMNS x COLUMNS cells
+    static constexpr int RENDERS_PER_FRAME = 4;
+
+    // Draws into the current cell: viewport, scissor and a cleared color and depth buffer are set up
+    using RenderFunction = std::function<void()>;
+
+    ThumbnailAtlas();
+    ~ThumbnailAtlas();
+
+    // Owns GL objects
+    ThumbnailAtlas(const ThumbnailAtlas&) = delete;
+    ThumbnailAtlas& operator=(const ThumbnailAtlas&) = delete;
+
+    void beginFrame();
+    bool get(uint64_t key, const RenderFunction& render, glm::vec2& uv0, glm::vec2& uv1);
+
+    GLuint getTexture() const { return texture; }
+    size_t getCachedCount() const { return cells.size(); }
+    int getLastRenderCount() const { return lastRenderCount; }
+
+private:
+    struct Cell {
+        int index;
+        uint64_t lastUsed;                              // Frame number
+    };
+
+    int findFreeCell();
+    void renderCell(int index, const RenderFunction& render);
+
+    GLuint framebuffer = 0, texture = 0, depthBuffer = 0;
+    std::unordered_map<uint64_t, Cell> cells;           // Keyed by content hash
+    std::vector<int> freeCells;
+
+    uint64_t frame = 0;
+    int renderCount = 0;                                // This frame
+    int lastRenderCount = 0;
+};
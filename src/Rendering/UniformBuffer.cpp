@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+// UniformBuffer.cpp -- Uniform buffer objects -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include "UniformBuffer.h"
+
+#include "StreamBuffer.h"
+
+/**
+* Create the buffer and attach it to its binding point.
+*
+* @param bindingPoint           [in] Binding point the block is assigned to (see UniformBinding).
+* @param size                   [in] Block size in bytes, as laid out by std140.
+*/
+
+UniformBuffer::UniformBuffer(GLuint bindingPoint, size_t size) : bindingPoint(bindingPoint), size(size) {
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, buffer);
+}
+
+UniformBuffer::~UniformBuffer() {
+    glDeleteBuffers(1, &buffer);
+}
+
+/**
+* Replace the whole block.
+*
+* @param data                   [in] size bytes, laid out as std140.
+*/
+
+void UniformBuffer::update(const void* data) const {
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, buffer);
+}
+
+/**
+* Create the ring.
+*
+* @param bindingPoint           [in] Binding point the block is assigned to (see UniformBinding).
+* @param blockSize              [in] Block size in bytes, as laid out by std140.
+*/
+
+UniformRing::UniformRing(GLuint bindingPoint, size_t blockSize) : bindingPoint(bindingPoint), blockSize(blockSize) {
+    GLint offsetAlignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &offsetAlignment);
+    alignment = size_t(offsetAlignment);
+}
+
+/**
+* Write the next copy of the block and bind it for the following draws.
+*
+* @param data                   [in] blockSize bytes, laid out as std140.
+*/
+
+void UniformRing::push(const void* data) const {
+    StreamBuffer& stream = StreamBuffer::getInstance();
+    size_t offset = stream.push(data, blockSize, alignment);
+    glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, stream.getBuffer(), offset, blockSize);
+}
@@ -0,0 +1,52 @@
+////////////////////////////////////////////////////////////////////////////////
+// UniformBuffer.h -- Uniform buffer objects include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+
+#include <GL/glew.h>
+
+// Uniform block binding points, shared by every program that declares the block
+enum UniformBinding : GLuint {
+    FRAME_UNIFORM_BINDING = 0,          // FrameData in object.vs/object.fs
+    OBJECT_UNIFORM_BINDING = 1          // ObjectData in object.vs/object.fs
+};
+
+/**
+* One std140 block, rewritten in full when it changes (e.g. once per frame).
+*/
+class UniformBuffer {
+public:
+    UniformBuffer(GLuint bindingPoint, size_t size);
+    ~UniformBuffer();
+
+    // Owns a GL buffer
+    UniformBuffer(const UniformBuffer&) = delete;
+    UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+    void update(const void* data) const;
+
+private:
+    GLuint buffer = 0;
+    GLuint bindingPoint;
+    size_t size;
+};
+
+/**
+* Many copies of a small std140 block, e.g. one per draw call. push() writes the next copy into the StreamBuffer
+* and binds just that range, so earlier draws still read their own copy and nothing waits for the GPU.
+*/
+class UniformRing {
+public:
+    UniformRing(GLuint bindingPoint, size_t blockSize);
+
+    void push(const void* data) const;
+
+private:
+    GLuint bindingPoint;
+    size_t blockSize;
+    size_t alignment;                   // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+};
@@ -85,8 +85,9 @@ BoundingBox BeybladeBody::getBoundingBox() const {
 
 /*--------------------------------------------Collision Calculations--------------------------------------------*/
 
-Scalar BeybladeBody::sampleRecoil() const
+Scalar BeybladeBody::sampleRecoil(std::mt19937* generator) const
 {
+    if (generator != nullptr) return layer->recoilDistribution.sample(*generator);
     return layer->recoilDistribution.sample();
 }
 
@@ -71,7 +71,7 @@ public:
 	void setVelocityY(M_S newY) { velocity.setY(newY); }
 
 	// Used in collision calculations
-	Scalar sampleRecoil() const;
+	Scalar sampleRecoil(std::mt19937* generator = nullptr) const;
 	static std::optional<M> distanceOverlap(BeybladeBody* a, BeybladeBody* b);
 
 	// Accumulators
@@ -30,6 +30,15 @@ public:
         return Scalar(distribution(rng));
     }
 
+    /**
+    * Samples using a caller-owned generator, e.g. a seeded one per simulation. Does not touch any shared state,
+    * so it is safe to call from several threads at once.
+    */
+    Scalar sample(std::mt19937& generator) const {
+        std::lognormal_distribution<float> localDistribution(distribution.param());
+        return Scalar(localDistribution(generator));
+    }
+
     Scalar getMean()   const { return mean; }
     Scalar getStdDev() const { return stddev; }
 
@@ -0,0 +1,45 @@
+////////////////////////////////////////////////////////////////////////////////
+// StadiumBody.h -- Stadium Physics include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include "Units.h"
+using namespace Units;
+
+/**
+ * StadiumBody. Contains the physical properties of a stadium, with no mesh or GL state, so it can be copied
+ * freely into headless simulations. Stadium derives from this and adds the rendering side.
+ *
+ * The surface is the paraboloid y = scaledCurvature * r^2 around center, where scaledCurvature = curvature / radius.
+ */
+class StadiumBody {
+public:
+    StadiumBody(const glm::vec3& center, float radius, float curvature, float coefficientOfFriction)
+        : center(Vec3_M(center)),
+        radius(M(radius)),
+        curvature(Scalar(curvature)),
+        scaledCurvature(__M(curvature / radius)),
+        coefficientOfFriction(Scalar(coefficientOfFriction)) {
+    }
+
+    bool isInside(M x, M z) const;
+    const M getYLocal(M r) const;
+    const M getY(M x, M z) const;
+    const Vec3_Scalar getNormal(M x, M z) const;
+
+    Vec3_M getCenter() const { return center; }
+    const M getRadius() const { return radius; }
+    const Scalar getCurvature() const { return curvature; }
+    Scalar getCOF() const { return coefficientOfFriction; }
+
+protected:
+    Vec3_M center;
+    M radius;
+    Scalar curvature;
+    __M scaledCurvature;
+    Scalar coefficientOfFriction;
+};
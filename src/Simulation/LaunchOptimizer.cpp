@@ -0,0 +1,183 @@
+////////////////////////////////////////////////////////////////////////////////
+// LaunchOptimizer.cpp -- Launch parameter search -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+
+#include "LaunchOptimizer.h"
+
+using namespace std;
+
+static constexpr int LAUNCH_COMPONENTS = 9;
+
+// LaunchParameters as a flat vector: center xyz, velocity xyz, angular velocity xyz
+static float& launchComponent(LaunchParameters& launch, int i) {
+    glm::vec3& v = i < 3 ? launch.center : (i < 6 ? launch.velocity : launch.angularVelocity);
+    return v[i % 3];
+}
+
+static float launchComponent(const LaunchParameters& launch, int i) {
+    return launchComponent(const_cast<LaunchParameters&>(launch), i);
+}
+
+/**
+* @param rules                  [in] World whose physics constants and spin thresholds are used.
+* @param build                  [in] Body being optimized, copied.
+* @param opponent               [in] Body it plays against, copied.
+* @param stadium                [in] Stadium the matches are played in, copied.
+* @param workerCount            [in] Number of simulation threads.
+*/
+
+LaunchOptimizer::LaunchOptimizer(const PhysicsWorld& rules, const BeybladeBody& build, const BeybladeBody& opponent, const StadiumBody& stadium,
+    unsigned workerCount)
+    : rules(rules), build(build), opponent(opponent), stadium(stadium), scheduler(workerCount)
+{
+    this->rules.resetPhysics();
+}
+
+/**
+* Search for the launch with the best win rate. Blocks until done or cancel() is called from another thread.
+*
+* @param start                  [in] Launch the search starts around, usually the current one.
+* @param bounds                 [in] Range of every launch value.
+* @param opponents              [in] Distribution of opponent launches.
+* @param options                [in] Search size and match settings.
+*
+* @return The best launch found and its record against the scenarios.
+*/
+
+LaunchEvaluation LaunchOptimizer::optimize(const LaunchParameters& start, const LaunchSearchBounds& bounds, const OpponentLaunches& opponents,
+    const LaunchOptimizerOptions& options)
+{
+    cancelled = false;
+    generation = 0;
+    matchCount = 0;
+
+    mt19937 generator(options.seed);
+    uniform_real_distribution<float> unit(-1.0f, 1.0f);
+    normal_distribution<float> normal(0.0f, 1.0f);
+
+    // Common random numbers: every candidate of every generation plays this same set
+    scenarios.clear();
+    for (int s = 0; s < options.scenarios; ++s) {
+        Scenario scenario;
+        for (int i = 0; i < LAUNCH_COMPONENTS; ++i) {
+            launchComponent(scenario.opponent, i) = launchComponent(opponents.mean, i) + unit(generator) * launchComponent(opponents.spread, i);
+        }
+        scenario.seed = generator();
+        scenarios.push_back(scenario);
+    }
+
+    float mean[LAUNCH_COMPONENTS], sigma[LAUNCH_COMPONENTS], minSigma[LAUNCH_COMPONENTS];
+    for (int i = 0; i < LAUNCH_COMPONENTS; ++i) {
+        float lo = launchComponent(bounds.min, i), hi = launchComponent(bounds.max, i);
+        mean[i] = clamp(launchComponent(start, i), lo, hi);
+        sigma[i] = (hi - lo) * 0.25f;
+        minSigma[i] = (hi - lo) * 0.01f;    // Keep exploring a little so the search cannot stall on one point
+    }
+
+    LaunchEvaluation best;
+    best.launch = start;
+    bool haveBest = false;
+
+    for (int g = 0; g < options.generations && !cancelled; ++g) {
+        generation = g;
+
+        vector<LaunchParameters> candidates(options.population);
+        for (int c = 0; c < options.population; ++c) {
+            for (int i = 0; i < LAUNCH_COMPONENTS; ++i) {
+                float value = c == 0 ? mean[i] : mean[i] + sigma[i] * normal(generator);    // Always re-test the mean
+                launchComponent(candidates[c], i) = clamp(value, launchComponent(bounds.min, i), launchComponent(bounds.max, i));
+            }
+        }
+
+        vector<LaunchEvaluation> evaluations = evaluate(candidates, options);
+        if (cancelled) break;
+
+        sort(evaluations.begin(), evaluations.end(), [](const LaunchEvaluation& a, const LaunchEvaluation& b) {
+            return a.winRate > b.winRate;
+        });
+        if (!haveBest || evaluations[0].winRate > best.winRate) {
+            best = evaluations[0];
+            haveBest = true;
+        }
+
+        int elites = max(1, min(options.eliteCount, int(evaluations.size())));
+        for (int i = 0; i < LAUNCH_COMPONENTS; ++i) {
+            float sum = 0.0f, sumSquares = 0.0f;
+            for (int e = 0; e < elites; ++e) {
+                float value = launchComponent(evaluations[e].launch, i);
+                sum += value;
+                sumSquares += value * value;
+            }
+            mean[i] = sum / elites;
+            sigma[i] = max(minSigma[i], sqrt(max(0.0f, sumSquares / elites - mean[i] * mean[i])));
+        }
+    }
+
+    generation = options.generations;
+    return best;
+}
+
+/**
+* Play every candidate against every scenario, one scheduler job per match.
+*/
+
+vector<LaunchEvaluation> LaunchOptimizer::evaluate(const vector<LaunchParameters>& candidates, const LaunchOptimizerOptions& options) {
+    size_t scenarioCount = scenarios.size();
+    vector<int> outcomes(candidates.size() * scenarioCount, 0);
+
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        for (size_t s = 0; s < scenarioCount; ++s) {
+            SimulationJob job;
+            job.id = "launch/" + to_string(generation) + "/" + to_string(c) + "/" + to_string(s);
+            job.priority = JobPriority::INTERACTIVE;
+            job.persistent = false;
+            job.run = [this, &candidates, &outcomes, &options, c, s, scenarioCount]() {
+                if (cancelled) return string();
+                int outcome = playMatch(candidates[c], scenarios[s], options);
+                outcomes[c * scenarioCount + s] = outcome;
+                ++matchCount;
+                return to_string(outcome);
+            };
+            scheduler.submit(std::move(job));
+        }
+    }
+    scheduler.waitIdle();
+
+    vector<LaunchEvaluation> evaluations(candidates.size());
+    for (size_t c = 0; c < candidates.size(); ++c) {
+        LaunchEvaluation& evaluation = evaluations[c];
+        evaluation.launch = candidates[c];
+        for (size_t s = 0; s < scenarioCount; ++s) {
+            int outcome = outcomes[c * scenarioCount + s];
+            if (outcome > 0) ++evaluation.wins;
+            else if (outcome < 0) ++evaluation.losses;
+            else ++evaluation.draws;
+        }
+        if (scenarioCount > 0) evaluation.winRate = (evaluation.wins + 0.5f * evaluation.draws) / scenarioCount;
+    }
+    return evaluations;
+}
+
+/**
+* Play one match headlessly.
+*
+* @return 1 if the build wins, -1 if it loses, 0 for a draw.
+*/
+
+int LaunchOptimizer::playMatch(const LaunchParameters& launch, const Scenario& scenario, const LaunchOptimizerOptions& options) const {
+    SimulationWorld world(rules, { build, opponent }, { stadium }, scenario.seed);
+    world.launch(0, launch);
+    world.launch(1, scenario.opponent);
+
+    PhysicsWorld::StepResult result = world.run(options.maxDuration, options.timeStep);
+    int loser = result.spinOut >= 0 ? result.spinOut : result.outOfBounds;
+    if (loser == 0) return -1;
+    if (loser == 1) return 1;
+    return 0;
+}
@@ -0,0 +1,90 @@
+////////////////////////////////////////////////////////////////////////////////
+// LaunchOptimizer.h -- Launch parameter search include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "SimulationScheduler.h"
+#include "SimulationWorld.h"
+
+/**
+* Range searched for each launch value. Set min and max equal to hold a value fixed.
+*/
+struct LaunchSearchBounds {
+    LaunchParameters min;
+    LaunchParameters max;
+};
+
+/**
+* Opponent launches the build is optimized against: each value is drawn uniformly from mean +/- spread.
+*/
+struct OpponentLaunches {
+    LaunchParameters mean;
+    LaunchParameters spread;
+};
+
+struct LaunchOptimizerOptions {
+    int generations = 8;
+    int population = 24;                // Candidates per generation
+    int eliteCount = 6;                 // Best candidates the next generation is sampled around
+    int scenarios = 24;                 // Opponent launches each candidate plays against
+    float maxDuration = 10.0f;          // Simulated seconds before a match counts as a draw
+    float timeStep = 1.0f / 240.0f;
+    uint32_t seed = 1;
+};
+
+struct LaunchEvaluation {
+    LaunchParameters launch;
+    float winRate = 0.0f;               // Draws count as half a win
+    int wins = 0;
+    int losses = 0;
+    int draws = 0;
+};
+
+/**
+* Searches for the launch that gives a build the best win rate against an opponent, by playing headless
+* SimulationWorld matches in parallel on a SimulationScheduler.
+*
+* The search is a cross-entropy method: each generation samples candidates around the best ones of the last.
+* Every candidate plays the same scenarios (opponent launch and recoil seed), so differences between candidates
+* come from their launches and not from luck of the draw.
+*/
+class LaunchOptimizer {
+public:
+    LaunchOptimizer(const PhysicsWorld& rules, const BeybladeBody& build, const BeybladeBody& opponent, const StadiumBody& stadium,
+        unsigned workerCount = std::thread::hardware_concurrency());
+
+    LaunchEvaluation optimize(const LaunchParameters& start, const LaunchSearchBounds& bounds, const OpponentLaunches& opponents,
+        const LaunchOptimizerOptions& options = LaunchOptimizerOptions());
+
+    void cancel() { cancelled = true; }
+    bool wasCancelled() const { return cancelled; }
+    int getGeneration() const { return generation; }
+    size_t getMatchCount() const { return matchCount; }
+
+private:
+    struct Scenario {
+        LaunchParameters opponent;
+        uint32_t seed;
+    };
+
+    std::vector<LaunchEvaluation> evaluate(const std::vector<LaunchParameters>& candidates, const LaunchOptimizerOptions& options);
+    int playMatch(const LaunchParameters& launch, const Scenario& scenario, const LaunchOptimizerOptions& options) const;
+
+    PhysicsWorld rules;
+    BeybladeBody build;
+    BeybladeBody opponent;
+    StadiumBody stadium;
+
+    std::vector<Scenario> scenarios;
+    SimulationScheduler scheduler;
+
+    std::atomic<bool> cancelled{ false };
+    std::atomic<int> generation{ 0 };
+    std::atomic<size_t> matchCount{ 0 };
+};
@@ -0,0 +1,448 @@
+////////////////////////////////////////////////////////////////////////////////
+// MatchResultStore.cpp -- Columnar match result storage -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+//
+// File layout (little endian):
+//   "BBMR" u32 version u32 columnCount { u8 type u8 nameLength name }*
+//   chunk*: "CHNK" u32 rows { u32 compressedSize u32 rawSize f64 min f64 max }*columnCount
+//           then each column's zlib data in column order
+////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <limits>
+#include <zlib.h>
+
+#include "MatchResultStore.h"
+
+using namespace std;
+
+static constexpr char FILE_MAGIC[4] = { 'B', 'B', 'M', 'R' };
+static constexpr char CHUNK_MAGIC[4] = { 'C', 'H', 'N', 'K' };
+static constexpr uint32_t FILE_VERSION = 1;
+
+const ColumnInfo MATCH_COLUMNS[MATCH_COLUMN_COUNT] = {
+    { "layer1",           ColumnType::INT32,   offsetof(MatchResult, layer1) },
+    { "disc1",            ColumnType::INT32,   offsetof(MatchResult, disc1) },
+    { "driver1",          ColumnType::INT32,   offsetof(MatchResult, driver1) },
+    { "layer2",           ColumnType::INT32,   offsetof(MatchResult, layer2) },
+    { "disc2",            ColumnType::INT32,   offsetof(MatchResult, disc2) },
+    { "driver2",          ColumnType::INT32,   offsetof(MatchResult, driver2) },
+    { "stadiumRadius",    ColumnType::FLOAT32, offsetof(MatchResult, stadiumRadius) },
+    { "stadiumCurvature", ColumnType::FLOAT32, offsetof(MatchResult, stadiumCurvature) },
+    { "stadiumFriction",  ColumnType::FLOAT32, offsetof(MatchResult, stadiumFriction) },
+    { "launchSpeed1",     ColumnType::FLOAT32, offsetof(MatchResult, launchSpeed1) },
+    { "launchSpeed2",     ColumnType::FLOAT32, offsetof(MatchResult, launchSpeed2) },
+    { "seed",             ColumnType::INT64,   offsetof(MatchResult, seed) },
+    { "outcome",          ColumnType::INT32,   offsetof(MatchResult, outcome) },
+    { "duration",         ColumnType::FLOAT32, offsetof(MatchResult, duration) },
+    { "finalSpin1",       ColumnType::FLOAT32, offsetof(MatchResult, finalSpin1) },
+    { "finalSpin2",       ColumnType::FLOAT32, offsetof(MatchResult, finalSpin2) },
+};
+
+static size_t columnTypeSize(ColumnType type) {
+    return type == ColumnType::INT64 ? 8 : 4;
+}
+
+static double decodeValue(ColumnType type, const uint8_t* data) {
+    switch (type) {
+    case ColumnType::INT32: { int32_t v; memcpy(&v, data, 4); return double(v); }
+    case ColumnType::INT64: { int64_t v; memcpy(&v, data, 8); return double(v); }
+    case ColumnType::FLOAT32: { float v; memcpy(&v, data, 4); return double(v); }
+    }
+    return 0.0;
+}
+
+int findMatchColumn(const string& name) {
+    for (int c = 0; c < MATCH_COLUMN_COUNT; ++c) {
+        if (name == MATCH_COLUMNS[c].name) return c;
+    }
+    return -1;
+}
+
+double getMatchColumnValue(const MatchResult& row, int column) {
+    return decodeValue(MATCH_COLUMNS[column].type, reinterpret_cast<const uint8_t*>(&row) + MATCH_COLUMNS[column].offset);
+}
+
+template <typename T>
+static void writePod(ostream& out, const T& value) {
+    out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static bool readPod(istream& in, T& value) {
+    return bool(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+/*--------------------------------------------MatchResultWriter--------------------------------------------*/
+
+MatchResultWriter::~MatchResultWriter() {
+    close();
+}
+
+/**
+* Create a result file, or reopen an existing one for appending.
+*
+* @param path                   [in] File path.
+*
+* @return false if the file exists but is not a match result file of this version, or cannot be opened.
+*/
+
+bool MatchResultWriter::open(const string& filePath) {
+    close();
+    lock_guard<mutex> lock(writeMutex);
+    path = filePath;
+
+    bool exists = filesystem::exists(path) && filesystem::file_size(path) > 0;
+    if (exists) {
+        uint64_t dataEnd = 0;
+        {
+            MatchResultReader reader;
+            if (!reader.open(path)) {
+                cerr << "Error: " << path << " is not a compatible match result file" << endl;
+                return false;
+            }
+            dataEnd = reader.getDataEnd();
+        }
+        // Drop a chunk torn by a crash so new chunks stay reachable
+        if (dataEnd < filesystem::file_size(path)) {
+            filesystem::resize_file(path, dataEnd);
+        }
+    }
+
+    file.open(path, ios::binary | ios::app);
+    if (!file.is_open()) {
+        cerr << "Error: Could not open match result file " << path << endl;
+        return false;
+    }
+
+    if (!exists) {
+        file.write(FILE_MAGIC, 4);
+        writePod(file, FILE_VERSION);
+        writePod(file, uint32_t(MATCH_COLUMN_COUNT));
+        for (const ColumnInfo& column : MATCH_COLUMNS) {
+            writePod(file, uint8_t(column.type));
+            writePod(file, uint8_t(strlen(column.name)));
+            file.write(column.name, strlen(column.name));
+        }
+        file.flush();
+    }
+    return true;
+}
+
+/**
+* Buffer one row. A chunk is compressed and written once chunkRows rows are buffered.
+*/
+
+void MatchResultWriter::append(const MatchResult& row) {
+    lock_guard<mutex> lock(writeMutex);
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&row);
+    for (int c = 0; c < MATCH_COLUMN_COUNT; ++c) {
+        const uint8_t* value = bytes + MATCH_COLUMNS[c].offset;
+        columns[c].insert(columns[c].end(), value, value + columnTypeSize(MATCH_COLUMNS[c].type));
+    }
+    if (++bufferedRows >= chunkRows) writeChunk();
+}
+
+/**
+* Write out any buffered rows as a (possibly short) chunk.
+*/
+
+bool MatchResultWriter::flush() {
+    lock_guard<mutex> lock(writeMutex);
+    return writeChunk();
+}
+
+void MatchResultWriter::close() {
+    flush();
+    lock_guard<mutex> lock(writeMutex);
+    if (file.is_open()) file.close();
+}
+
+bool MatchResultWriter::writeChunk() {
+    if (bufferedRows == 0 || !file.is_open()) return true;
+
+    // Compress everything before writing, so a failure leaves no partial chunk in the file
+    vector<vector<uint8_t>> compressed(MATCH_COLUMN_COUNT);
+    vector<double> minValues(MATCH_COLUMN_COUNT), maxValues(MATCH_COLUMN_COUNT);
+    bool compressFailed = false;
+    for (int c = 0; c < MATCH_COLUMN_COUNT && !compressFailed; ++c) {
+        const vector<uint8_t>& raw = columns[c];
+        size_t stride = columnTypeSize(MATCH_COLUMNS[c].type);
+
+        double minValue = numeric_limits<double>::max();
+        double maxValue = numeric_limits<double>::lowest();
+        for (size_t i = 0; i < raw.size(); i += stride) {
+            double v = decodeValue(MATCH_COLUMNS[c].type, raw.data() + i);
+            minValue = std::min(minValue, v);
+            maxValue = std::max(maxValue, v);
+        }
+
+        uLongf compressedSize = compressBound(uLong(raw.size()));
+        compressed[c].resize(compressedSize);
+        if (compress2(compressed[c].data(), &compressedSize, raw.data(), uLong(raw.size()), Z_DEFAULT_COMPRESSION) != Z_OK) {
+            cerr << "Error: Failed to compress column " << MATCH_COLUMNS[c].name << ", dropping " << bufferedRows
+                << " rows" << endl;
+            compressFailed = true;
+        }
+        compressed[c].resize(compressedSize);
+        minValues[c] = minValue;
+        maxValues[c] = maxValue;
+    }
+
+    if (!compressFailed) {
+        file.write(CHUNK_MAGIC, 4);
+        writePod(file, bufferedRows);
+        for (int c = 0; c < MATCH_COLUMN_COUNT; ++c) {
+            writePod(file, uint32_t(compressed[c].size()));
+            writePod(file, uint32_t(columns[c].size()));
+            writePod(file, minValues[c]);
+            writePod(file, maxValues[c]);
+        }
+        for (int c = 0; c < MATCH_COLUMN_COUNT; ++c) {
+            file.write(reinterpret_cast<const char*>(compressed[c].data()), compressed[c].size());
+        }
+        file.flush();
+    }
+
+    for (vector<uint8_t>& column : columns) column.clear();
+    bufferedRows = 0;
+    if (compressFailed) return false;
+
+    if (!file) {
+        cerr << "Error: Failed writing to match result file " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+/*--------------------------------------------MatchPredicate--------------------------------------------*/
+
+bool MatchPredicate::test(double x) const {
+    switch (op) {
+    case CompareOp::EQ: return x == value;
+    case CompareOp::NE: return x != value;
+    case CompareOp::LT: return x < value;
+    case CompareOp::LE: return x <= value;
+    case CompareOp::GT: return x > value;
+    case CompareOp::GE: return x >= value;
+    }
+    return false;
+}
+
+/**
+* Whether any value in [chunkMin, chunkMax] can satisfy the predicate. False means the chunk can be skipped.
+*/
+
+bool MatchPredicate::mayMatch(double chunkMin, double chunkMax) const {
+    switch (op) {
+    case CompareOp::EQ: return value >= chunkMin && value <= chunkMax;
+    case CompareOp::NE: return !(chunkMin == value && chunkMax == value);
+    case CompareOp::LT: return chunkMin < value;
+    case CompareOp::LE: return chunkMin <= value;
+    case CompareOp::GT: return chunkMax > value;
+    case CompareOp::GE: return chunkMax >= value;
+    }
+    return true;
+}
+
+/**
+* Parse "column<op>value", e.g. "stadiumCurvature>0.2" or "driver1==3".
+*/
+
+bool parseMatchPredicate(const string& text, MatchPredicate& predicate) {
+    static const pair<const char*, CompareOp> ops[] = {
+        { "==", CompareOp::EQ }, { "!=", CompareOp::NE }, { "<=", CompareOp::LE },
+        { ">=", CompareOp::GE }, { "<", CompareOp::LT }, { ">", CompareOp::GT }, { "=", CompareOp::EQ }
+    };
+    for (const auto& [symbol, op] : ops) {
+        size_t pos = text.find(symbol);
+        if (pos == string::npos) continue;
+
+        int column = findMatchColumn(text.substr(0, pos));
+        if (column < 0) return false;
+        try {
+            predicate.value = stod(text.substr(pos + strlen(symbol)));
+        }
+        catch (const exception&) {
+            return false;
+        }
+        predicate.column = column;
+        predicate.op = op;
+        return true;
+    }
+    return false;
+}
+
+/*--------------------------------------------MatchResultReader--------------------------------------------*/
+
+/**
+* Open a result file and read its chunk directory. A torn final chunk is ignored.
+*/
+
+bool MatchResultReader::open(const string& path) {
+    chunks.clear();
+    rowCount = 0;
+    dataEnd = 0;
+    file.close();
+    file.open(path, ios::binary);
+    if (!file.is_open()) return false;
+
+    char magic[4];
+    uint32_t version, columnCount;
+    if (!file.read(magic, 4) || memcmp(magic, FILE_MAGIC, 4) != 0) return false;
+    if (!readPod(file, version) || version != FILE_VERSION) return false;
+    if (!readPod(file, columnCount) || columnCount != MATCH_COLUMN_COUNT) return false;
+    for (const ColumnInfo& column : MATCH_COLUMNS) {
+        uint8_t type, nameLength;
+        if (!readPod(file, type) || !readPod(file, nameLength)) return false;
+        string name(nameLength, '\0');
+        if (!file.read(name.data(), nameLength)) return false;
+        if (type != uint8_t(column.type) || name != column.name) return false;
+    }
+
+    uint64_t fileSize = filesystem::file_size(path);
+    uint64_t validEnd = uint64_t(file.tellg());
+    while (true) {
+        Chunk chunk;
+        if (!file.read(magic, 4) || memcmp(magic, CHUNK_MAGIC, 4) != 0) break;
+        if (!readPod(file, chunk.rows)) break;
+
+        bool headerOk = true;
+        for (ColumnChunk& column : chunk.columns) {
+            headerOk = headerOk && readPod(file, column.compressedSize) && readPod(file, column.rawSize)
+                && readPod(file, column.min) && readPod(file, column.max);
+        }
+        if (!headerOk) break;
+
+        // query() indexes every row of every column, so the sizes must agree with the row count
+        for (int c = 0; c < MATCH_COLUMN_COUNT; ++c) {
+            if (chunk.columns[c].rawSize != uint64_t(chunk.rows) * columnTypeSize(MATCH_COLUMNS[c].type)) {
+                cerr << "Error: Malformed chunk in match result file " << path << endl;
+                chunks.clear();
+                rowCount = 0;
+                file.close();
+                return false;
+            }
+        }
+
+        uint64_t offset = uint64_t(file.tellg());
+        for (ColumnChunk& column : chunk.columns) {
+            column.offset = offset;
+            offset += column.compressedSize;
+        }
+        if (offset > fileSize) break;
+
+        file.seekg(offset);
+        chunks.push_back(chunk);
+        rowCount += chunk.rows;
+        validEnd = offset;
+    }
+    file.clear();
+    dataEnd = validEnd;
+
+    if (validEnd < fileSize) {
+        cerr << "Warning: Ignoring " << (fileSize - validEnd) << " trailing bytes of incomplete chunk in " << path << endl;
+    }
+    return true;
+}
+
+bool MatchResultReader::readColumn(const ColumnChunk& column, vector<uint8_t>& out) {
+    vector<uint8_t> compressed(column.compressedSize);
+    file.seekg(column.offset);
+    if (!file.read(reinterpret_cast<char*>(compressed.data()), compressed.size())) {
+        file.clear();
+        return false;
+    }
+
+    out.resize(column.rawSize);
+    uLongf rawSize = column.rawSize;
+    return uncompress(out.data(), &rawSize, compressed.data(), uLong(compressed.size())) == Z_OK && rawSize == column.rawSize;
+}
+
+/**
+* Visit every row satisfying all predicates.
+*
+* Chunks whose min/max rule out any predicate are skipped without reading them. For the rest, the predicate
+* columns are inflated first; the remaining columns are only inflated if some row in the chunk matched.
+*
+* @param predicates             [in] Filters, ANDed together. Empty matches every row.
+* @param onRow                  [in] Called for every matching row. May be null to only count.
+* @param columns                [in] Columns to fill in the rows passed to onRow; empty for all. Others are left default.
+* @return                       Scan counters. failed is set if a chunk was unreadable, in which case rows after it
+*                               were not visited.
+*/
+
+MatchQueryStats MatchResultReader::query(const vector<MatchPredicate>& predicates, const function<void(const MatchResult&)>& onRow,
+    const vector<int>& columns) {
+    MatchQueryStats stats;
+    stats.chunksTotal = chunks.size();
+
+    vector<int> outputColumns = columns;
+    if (outputColumns.empty()) {
+        for (int c = 0; c < MATCH_COLUMN_COUNT; ++c) outputColumns.push_back(c);
+    }
+
+    vector<vector<uint8_t>> columnData(MATCH_COLUMN_COUNT);
+    vector<char> rowMatches;
+
+    for (const Chunk& chunk : chunks) {
+        bool skip = false;
+        for (const MatchPredicate& predicate : predicates) {
+            const ColumnChunk& column = chunk.columns[predicate.column];
+            if (!predicate.mayMatch(column.min, column.max)) {
+                skip = true;
+                break;
+            }
+        }
+        if (skip) {
+            ++stats.chunksSkipped;
+            continue;
+        }
+
+        bool loaded[MATCH_COLUMN_COUNT] = {};
+        rowMatches.assign(chunk.rows, 1);
+        for (const MatchPredicate& predicate : predicates) {
+            int c = predicate.column;
+            if (!loaded[c]) {
+                if (!readColumn(chunk.columns[c], columnData[c])) {
+                    stats.failed = true;
+                    return stats;
+                }
+                loaded[c] = true;
+            }
+            size_t stride = columnTypeSize(MATCH_COLUMNS[c].type);
+            for (uint32_t row = 0; row < chunk.rows; ++row) {
+                if (rowMatches[row] && !predicate.test(decodeValue(MATCH_COLUMNS[c].type, columnData[c].data() + row * stride))) {
+                    rowMatches[row] = 0;
+                }
+            }
+        }
+        stats.rowsScanned += chunk.rows;
+
+        size_t matched = 0;
+        for (char m : rowMatches) matched += m;
+        stats.rowsMatched += matched;
+        if (matched == 0 || !onRow) continue;
+
+        for (int c : outputColumns) {
+            if (!loaded[c] && !readColumn(chunk.columns[c], columnData[c])) {
+                stats.failed = true;
+                return stats;
+            }
+            loaded[c] = true;
+        }
+        for (uint32_t row = 0; row < chunk.rows; ++row) {
+            if (!rowMatches[row]) continue;
+            MatchResult result;
+            uint8_t* bytes = reinterpret_cast<uint8_t*>(&result);
+            for (int c : outputColumns) {
+                size_t stride = columnTypeSize(MATCH_COLUMNS[c].type);
+                memcpy(bytes + MATCH_COLUMNS[c].offset, columnData[c].data() + row * stride, stride);
+            }
+            onRow(result);
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+// MatchResultStore.h -- Columnar match result storage include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+* One simulated match. Part ids are indices into templateLayers/templateDiscs/templateDrivers.
+*/
+struct MatchResult {
+    int32_t layer1 = 0;
+    int32_t disc1 = 0;
+    int32_t driver1 = 0;
+    int32_t layer2 = 0;
+    int32_t disc2 = 0;
+    int32_t driver2 = 0;
+
+    float stadiumRadius = 0.0f;         // m
+    float stadiumCurvature = 0.0f;
+    float stadiumFriction = 0.0f;
+    float launchSpeed1 = 0.0f;          // m/s
+    float launchSpeed2 = 0.0f;          // m/s
+
+    int64_t seed = 0;
+    int32_t outcome = -1;               // 0 if bey 1 won, 1 if bey 2 won, -1 for a draw
+    float duration = 0.0f;              // s
+    float finalSpin1 = 0.0f;            // rad/s
+    float finalSpin2 = 0.0f;            // rad/s
+};
+
+enum class ColumnType : uint8_t {
+    INT32 = 0,
+    INT64 = 1,
+    FLOAT32 = 2
+};
+
+enum MatchColumn : int {
+    LAYER1, DISC1, DRIVER1, LAYER2, DISC2, DRIVER2,
+    STADIUM_RADIUS, STADIUM_CURVATURE, STADIUM_FRICTION, LAUNCH_SPEED1, LAUNCH_SPEED2,
+    SEED, OUTCOME, DURATION, FINAL_SPIN1, FINAL_SPIN2,
+    MATCH_COLUMN_COUNT
+};
+
+struct ColumnInfo {
+    const char* name;
+    ColumnType type;
+    size_t offset;      // Into MatchResult
+};
+
+extern const ColumnInfo MATCH_COLUMNS[MATCH_COLUMN_COUNT];
+
+int findMatchColumn(const std::string& name);
+double getMatchColumnValue(const MatchResult& row, int column);
+
+/**
+* Appends match results to a columnar file.
+*
+* Rows are buffered and written as chunks of chunkRows rows. Each column of a chunk is zlib compressed
+* separately and stored with its min/max, so readers can skip whole chunks and only inflate the columns they touch.
+* Opening an existing file appends to it (a torn final chunk from a crash is truncated first).
+*
+* Thread-safe: append() may be called from several SimulationScheduler workers.
+*/
+class MatchResultWriter {
+public:
+    MatchResultWriter(uint32_t chunkRows = 65536) : chunkRows(chunkRows) {}
+    ~MatchResultWriter();
+
+    MatchResultWriter(const MatchResultWriter&) = delete;
+    MatchResultWriter& operator=(const MatchResultWriter&) = delete;
+
+    bool open(const std::string& path);
+    void append(const MatchResult& row);
+    bool flush();
+    void close();
+
+private:
+    bool writeChunk();
+
+    std::mutex writeMutex;
+    std::ofstream file;
+    std::string path;
+
+    uint32_t chunkRows;
+    uint32_t bufferedRows = 0;
+    std::vector<std::vector<uint8_t>> columns = std::vector<std::vector<uint8_t>>(MATCH_COLUMN_COUNT);
+};
+
+enum class CompareOp {
+    EQ, NE, LT, LE, GT, GE
+};
+
+/**
+* A single "column op value" filter. Queries AND all their predicates together.
+*/
+struct MatchPredicate {
+    int column = 0;
+    CompareOp op = CompareOp::EQ;
+    double value = 0.0;
+
+    bool test(double x) const;
+    bool mayMatch(double chunkMin, double chunkMax) const;
+};
+
+bool parseMatchPredicate(const std::string& text, MatchPredicate& predicate);
+
+struct MatchQueryStats {
+    size_t chunksTotal = 0;
+    size_t chunksSkipped = 0;
+    size_t rowsScanned = 0;
+    size_t rowsMatched = 0;
+    bool failed = false;            // A chunk could not be read or inflated; the query stopped there
+};
+
+/**
+* Reads a file produced by MatchResultWriter. Only the chunk directory is read on open.
+*/
+class MatchResultReader {
+public:
+    bool open(const std::string& path);
+
+    uint64_t getRowCount() const { return rowCount; }
+    size_t getChunkCount() const { return chunks.size(); }
+    uint64_t getDataEnd() const { return dataEnd; }       // End of the last complete chunk
+
+    MatchQueryStats query(const std::vector<MatchPredicate>& predicates,
+        const std::function<void(const MatchResult&)>& onRow, const std::vector<int>& columns = {});
+
+private:
+    struct ColumnChunk {
+        uint64_t offset = 0;            // Of the compressed data in the file
+        uint32_t compressedSize = 0;
+        uint32_t rawSize = 0;
+        double min = 0.0;
+        double max = 0.0;
+    };
+
+    struct Chunk {
+        uint32_t rows = 0;
+        ColumnChunk columns[MATCH_COLUMN_COUNT];
+    };
+
+    bool readColumn(const ColumnChunk& column, std::vector<uint8_t>& out);
+
+    std::ifstream file;
+    std::vector<Chunk> chunks;
+    uint64_t rowCount = 0;
+    uint64_t dataEnd = 0;
+};
@@ -0,0 +1,43 @@
+////////////////////////////////////////////////////////////////////////////////
+// SimulationJob.h -- Batch simulation job include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+
+/**
+* Scheduling priority of a job. Higher priorities are always dequeued first, so an interactive query
+* submitted in the middle of a long sweep runs as soon as the next worker frees up.
+*/
+enum class JobPriority : int {
+    BACKGROUND = 0,     // Long parameter sweeps, tournaments
+    NORMAL = 1,
+    INTERACTIVE = 2     // Something the player is waiting on
+};
+
+/**
+* A single unit of batch work, usually one simulated match.
+*
+* The id must be stable across runs (e.g. "sweep3/layer2-disc0-driver1/seed17") since it is what the
+* journal uses to decide whether the job was already completed by a previous process.
+* The result is an opaque string, typically a serialized json object.
+*/
+struct SimulationJob {
+    std::string id;
+    JobPriority priority = JobPriority::NORMAL;
+    bool persistent = true;                     // Write the result to the journal once finished
+    std::function<std::string()> run;
+
+    uint64_t sequence = 0;                      // Assigned by the scheduler, keeps FIFO order within a priority
+};
+
+struct SimulationJobComparison {
+    bool operator()(const SimulationJob& a, const SimulationJob& b) const {
+        if (a.priority != b.priority) return a.priority < b.priority;
+        return a.sequence > b.sequence;
+    }
+};
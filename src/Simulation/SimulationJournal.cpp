@@ -0,0 +1,176 @@
+////////////////////////////////////////////////////////////////////////////////
+// SimulationJournal.cpp -- Append-only job journal -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <json.hpp>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "SimulationJournal.h"
+
+using namespace std;
+using namespace nlohmann;
+
+SimulationJournal::~SimulationJournal() {
+    close();
+}
+
+/**
+* Open (or create) a journal, replaying any records left by a previous run.
+*
+* @param path                   [in] Journal file path.
+*
+* @return false if the file could not be opened for appending.
+*/
+
+bool SimulationJournal::open(const string& journalPath) {
+    close();
+    path = journalPath;
+
+    if (filesystem::exists(path) && !replay(path)) {
+        return false;
+    }
+
+    file = fopen(path.c_str(), "ab");
+    if (!file) {
+        cerr << "Error: Could not open simulation journal " << path << endl;
+        return false;
+    }
+    lastSync = chrono::steady_clock::now();
+    return true;
+}
+
+void SimulationJournal::close() {
+    if (!file) return;
+    flush();
+    fclose(file);
+    file = nullptr;
+}
+
+/**
+* Load completed records. Complete lines that fail to parse are skipped and left in place so no later record is
+* lost. Only a final line without its newline (a crash mid-write) is cut off so new records are appended onto a
+* clean boundary.
+*/
+
+bool SimulationJournal::replay(const string& journalPath) {
+    ifstream in(journalPath, ios::binary);
+    if (!in.is_open()) {
+        cerr << "Error: Could not read simulation journal " << journalPath << endl;
+        return false;
+    }
+
+    uintmax_t validBytes = 0;
+    size_t skipped = 0;
+    string line;
+    while (getline(in, line)) {
+        // A final line without its newline was never fully written
+        if (in.eof()) break;
+
+        validBytes += line.size() + 1;
+        try {
+            json record = json::parse(line);
+            completed[record.at("id").get<string>()] = record.at("result").get<string>();
+        }
+        catch (const json::exception&) {
+            ++skipped;
+        }
+    }
+    in.close();
+
+    if (skipped > 0) {
+        cerr << "Warning: Skipped " << skipped << " unreadable records in simulation journal " << journalPath << endl;
+    }
+
+    error_code ec;
+    if (validBytes < filesystem::file_size(journalPath, ec) && !ec) {
+        cerr << "Warning: Discarding a torn record at the end of simulation journal " << journalPath << endl;
+        filesystem::resize_file(journalPath, validBytes, ec);
+    }
+    return !ec;
+}
+
+/**
+* Record a completed job. The record becomes durable at the next batch sync.
+*
+* @param jobId                  [in] Stable job identifier.
+* @param result                 [in] Serialized result.
+*/
+
+void SimulationJournal::append(const string& jobId, const string& result) {
+    string batch;
+    {
+        lock_guard<mutex> lock(dataMutex);
+        completed[jobId] = result;
+        if (!file) return;
+
+        pending += json{ {"id", jobId}, {"result", result} }.dump();
+        pending += '\n';
+        ++pendingCount;
+
+        auto now = chrono::steady_clock::now();
+        if (pendingCount < flushBatchSize && now - lastSync < flushInterval) return;
+
+        batch.swap(pending);
+        pendingCount = 0;
+        lastSync = now;
+    }
+    writeAndSync(batch);
+}
+
+/**
+* Write out and sync everything appended so far, regardless of batch size.
+*/
+
+void SimulationJournal::flush() {
+    string batch;
+    {
+        lock_guard<mutex> lock(dataMutex);
+        batch.swap(pending);
+        pendingCount = 0;
+        lastSync = chrono::steady_clock::now();
+    }
+    writeAndSync(batch);
+}
+
+void SimulationJournal::writeAndSync(const string& data) {
+    if (data.empty()) return;
+
+    lock_guard<mutex> lock(ioMutex);
+    if (!file) return;
+    if (fwrite(data.data(), 1, data.size(), file) != data.size()) {
+        cerr << "Error: Failed writing to simulation journal " << path << endl;
+        return;
+    }
+    fflush(file);
+#ifdef _WIN32
+    _commit(_fileno(file));
+#else
+    fsync(fileno(file));
+#endif
+}
+
+bool SimulationJournal::contains(const string& jobId) const {
+    lock_guard<mutex> lock(dataMutex);
+    return completed.find(jobId) != completed.end();
+}
+
+optional<string> SimulationJournal::getResult(const string& jobId) const {
+    lock_guard<mutex> lock(dataMutex);
+    auto it = completed.find(jobId);
+    if (it == completed.end()) return nullopt;
+    return it->second;
+}
+
+size_t SimulationJournal::size() const {
+    lock_guard<mutex> lock(dataMutex);
+    return completed.size();
+}
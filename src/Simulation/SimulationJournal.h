@@ -0,0 +1,63 @@
+////////////////////////////////////////////////////////////////////////////////
+// SimulationJournal.h -- Append-only job journal include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+/**
+* Append-only record of completed simulation jobs, one json object per line: {"id": ..., "result": ...}
+*
+* Records are buffered in memory and written + fsync'd in batches (every flushBatchSize records or
+* flushInterval, whichever comes first), so the cost of durability is amortized over many jobs.
+* A crash loses at most one unsynced batch; a torn final line is detected and truncated on open.
+*
+* Thread-safe: append() may be called concurrently from the scheduler's workers.
+*/
+class SimulationJournal {
+public:
+    SimulationJournal(size_t flushBatchSize = 64, std::chrono::milliseconds flushInterval = std::chrono::milliseconds(2000))
+        : flushBatchSize(flushBatchSize), flushInterval(flushInterval) {}
+    ~SimulationJournal();
+
+    SimulationJournal(const SimulationJournal&) = delete;
+    SimulationJournal& operator=(const SimulationJournal&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return file != nullptr; }
+
+    void append(const std::string& jobId, const std::string& result);
+    void flush();
+
+    bool contains(const std::string& jobId) const;
+    std::optional<std::string> getResult(const std::string& jobId) const;
+    size_t size() const;
+
+private:
+    bool replay(const std::string& path);
+    void writeAndSync(const std::string& data);
+
+    std::FILE* file = nullptr;
+    std::string path;
+
+    size_t flushBatchSize;
+    std::chrono::milliseconds flushInterval;
+
+    // Guards completed, pending and the batch counters
+    mutable std::mutex dataMutex;
+    std::unordered_map<std::string, std::string> completed;
+    std::string pending;
+    size_t pendingCount = 0;
+    std::chrono::steady_clock::time_point lastSync;
+
+    // Serializes file writes. Held without dataMutex so workers keep appending while a batch is synced.
+    std::mutex ioMutex;
+};
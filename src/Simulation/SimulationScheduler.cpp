@@ -0,0 +1,144 @@
+////////////////////////////////////////////////////////////////////////////////
+// SimulationScheduler.cpp -- Batch simulation scheduler -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>
+
+#include "SimulationScheduler.h"
+
+using namespace std;
+
+SimulationScheduler::SimulationScheduler(unsigned workerCount) : workerCount(workerCount == 0 ? 1 : workerCount) {}
+
+SimulationScheduler::~SimulationScheduler() {
+    stop();
+}
+
+/**
+* Attach a journal. Should be called before submitting the batch so completed jobs can be skipped.
+*
+* @param path                   [in] Journal file path, created if missing.
+*/
+
+bool SimulationScheduler::openJournal(const string& path) {
+    if (!journal.open(path)) return false;
+    if (journal.size() > 0) {
+        cout << "Resuming from simulation journal " << path << " (" << journal.size() << " jobs already completed)" << endl;
+    }
+    return true;
+}
+
+/**
+* Queue a job.
+*
+* @param job                    [in] Job to run. Its sequence is overwritten.
+*
+* @return false if the job was already completed according to the journal, or the scheduler is stopping.
+*/
+
+bool SimulationScheduler::submit(SimulationJob job) {
+    if (job.persistent) {
+        optional<string> previous = journal.getResult(job.id);
+        if (previous.has_value()) {
+            ++skippedCount;
+            if (onComplete) onComplete(job.id, previous.value());
+            return false;
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (stopping) return false;
+        job.sequence = nextSequence++;
+        jobs.push(std::move(job));
+        if (workers.empty()) startWorkers();
+    }
+    queueCondition.notify_one();
+    return true;
+}
+
+/**
+* Block until the queue is drained and no job is running, then sync the journal. Returns right away once stopped,
+* since the queued jobs are never run.
+*/
+
+void SimulationScheduler::waitIdle() {
+    {
+        unique_lock<mutex> lock(queueMutex);
+        idleCondition.wait(lock, [this] { return stopping || (jobs.empty() && runningCount == 0); });
+        if (stopping) return;
+    }
+    journal.flush();
+}
+
+/**
+* Finish the running jobs, drop the queued ones and join the workers. Queued persistent jobs are picked up
+* again on the next run since they never reached the journal.
+*/
+
+void SimulationScheduler::stop() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        if (stopping) return;
+        stopping = true;
+    }
+    queueCondition.notify_all();
+    idleCondition.notify_all();
+    for (thread& worker : workers) {
+        if (worker.joinable()) worker.join();
+    }
+    journal.close();
+}
+
+size_t SimulationScheduler::getQueuedCount() const {
+    lock_guard<mutex> lock(queueMutex);
+    return jobs.size();
+}
+
+// Called with queueMutex held
+void SimulationScheduler::startWorkers() {
+    workers.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        workers.emplace_back(&SimulationScheduler::workerLoop, this);
+    }
+}
+
+void SimulationScheduler::workerLoop() {
+    while (true) {
+        SimulationJob job;
+        {
+            unique_lock<mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (stopping) return;
+
+            // priority_queue::top is const, but the element is popped right after
+            job = std::move(const_cast<SimulationJob&>(jobs.top()));
+            jobs.pop();
+            ++runningCount;
+        }
+
+        string result;
+        bool succeeded = true;
+        try {
+            result = job.run ? job.run() : string();
+        }
+        catch (const exception& e) {
+            cerr << "Error: Simulation job " << job.id << " failed: " << e.what() << endl;
+            succeeded = false;
+        }
+
+        // Failed jobs are not journaled so they are retried on resume
+        if (succeeded) {
+            if (job.persistent) journal.append(job.id, result);
+            ++completedCount;
+            if (onComplete) onComplete(job.id, result);
+        }
+
+        {
+            lock_guard<mutex> lock(queueMutex);
+            --runningCount;
+            if (jobs.empty() && runningCount == 0) idleCondition.notify_all();
+        }
+    }
+}
@@ -0,0 +1,72 @@
+////////////////////////////////////////////////////////////////////////////////
+// SimulationScheduler.h -- Batch simulation scheduler include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include "SimulationJob.h"
+#include "SimulationJournal.h"
+
+/**
+* Runs batches of simulation jobs (sweeps, tournaments, Monte Carlo matchups) on a pool of worker threads.
+*
+* Completed persistent jobs are recorded in a SimulationJournal. Opening the same journal again after a crash
+* resumes the batch: submit() silently drops any job whose id is already journaled and instead reports the
+* stored result through the completion callback.
+*
+* The workers start with the first queued job, so openJournal() and setCompletionCallback() must be called before
+* submitting.
+*/
+class SimulationScheduler {
+public:
+    using CompletionCallback = std::function<void(const std::string& jobId, const std::string& result)>;
+
+    SimulationScheduler(unsigned workerCount = std::thread::hardware_concurrency());
+    ~SimulationScheduler();
+
+    SimulationScheduler(const SimulationScheduler&) = delete;
+    SimulationScheduler& operator=(const SimulationScheduler&) = delete;
+
+    bool openJournal(const std::string& path);
+    void setCompletionCallback(CompletionCallback callback) { onComplete = std::move(callback); }
+
+    bool submit(SimulationJob job);
+    void waitIdle();
+    void stop();
+
+    size_t getQueuedCount() const;
+    size_t getCompletedCount() const { return completedCount; }
+    size_t getSkippedCount() const { return skippedCount; }
+
+    SimulationJournal& getJournal() { return journal; }
+
+private:
+    void startWorkers();
+    void workerLoop();
+
+    SimulationJournal journal;
+    CompletionCallback onComplete;
+
+    mutable std::mutex queueMutex;
+    std::condition_variable queueCondition;
+    std::condition_variable idleCondition;
+    std::priority_queue<SimulationJob, std::vector<SimulationJob>, SimulationJobComparison> jobs;
+    uint64_t nextSequence = 0;
+    size_t runningCount = 0;
+    bool stopping = false;
+
+    std::atomic<size_t> completedCount{ 0 };
+    std::atomic<size_t> skippedCount{ 0 };
+
+    unsigned workerCount;
+    std::vector<std::thread> workers;
+};
@@ -3,9 +3,12 @@
 #include "StateIdentifiers.h"
 #include "BeybladeConstants.h"
 #include "Beyblade.h"
+#include "MeshManager.h"
 #include "Stadium.h"
 #include "ProfileManager.h"
 #include "ImGuiUI.h"
+#include "ObjectShader.h"
+#include "Thumbnails.h"
 #include "../lib/ImGuiFileDialog/ImGuiFileDialog.h"
 #include "../lib/ImGuiFileDialog/ImGuiFileDialogConfig.h"
 #include <glm/gtc/type_ptr.hpp>
@@ -179,6 +182,9 @@ shared_ptr<Beyblade> CustomizeState::drawBeybladeSection(
         [&]() {
             currentPopup = PopupState::DELETE_BEYBLADE;
             OpenPopup("Confirm Beyblade Deletion");
+        },
+        [&](const shared_ptr<Beyblade>& beyblade) {
+            beybladeThumbnail(*game->thumbnails, *game->objectShader, *beyblade, THUMBNAIL_SIZE);
         }
     );
 }
@@ -202,6 +208,9 @@ shared_ptr<Stadium> CustomizeState::drawStadiumSection(
         [&]() {
             currentPopup = PopupState::DELETE_STADIUM;
             OpenPopup("Confirm Stadium Deletion");
+        },
+        [&](const shared_ptr<Stadium>& stadium) {
+            stadiumThumbnail(*game->thumbnails, *game->objectShader, *stadium, THUMBNAIL_SIZE);
         }
     );
 
@@ -271,13 +280,25 @@ void CustomizeState::drawManualCustomizeSection(shared_ptr<Beyblade> beyblade) {
     if (ImGuiFileDialog::Instance()->Display("Dlg##SelectMesh", ImGuiWindowFlags_None, ImVec2(800, 600))) {
         if (ImGuiFileDialog::Instance()->IsOk()) {
             string filePathName = ImGuiFileDialog::Instance()->GetFilePathName();
-            auto newMesh = make_unique<BeybladeMesh>(filePathName.c_str());  // This loads the mesh.
-            if (newMesh != nullptr && newMesh->modelLoaded) {
-                beyblade->setMesh(newMesh);
-            }
-            else {
-                game->ml.addMessage("Failed to load mesh. Ensure it is a valid .obj file", MessageType::ERROR, true);
-            }
+            ImGuiFileDialog::Instance()->Close();
+
+            // Uploads can be large: parse and cache on the loading screen's thread, then upload from the cache here
+            GameEngine* engine = game;
+            game->pushState(StateFactory::createLoadingState(
+                game,
+                { [filePathName](const LoadingProgress& onProgress) { return BeybladeMesh::importModel(filePathName, onProgress); } },
+                [engine, beyblade, filePathName]() {
+                    engine->popState();
+                    auto newMesh = MeshManager::getInstance().getMesh(filePathName);  // Loads from the .bbmesh just written
+                    if (newMesh != nullptr && newMesh->modelLoaded) {
+                        beyblade->setMesh(newMesh);
+                    }
+                    else {
+                        engine->ml.addMessage("Failed to load mesh. Ensure it is a valid .obj file", MessageType::ERROR, true);
+                    }
+                }
+            ));
+            return;
         }
         ImGuiFileDialog::Instance()->Close();  // Close the dialog
         return;
@@ -36,6 +36,7 @@ public:
 private:
     float leftTextWidth, rightButton1Width, rightButton2Width;  // Static, initialized in init()
     float rightButton1X, rightButton2X, dropdownLeftX, dropdownWidth; // Change during onResize();
+    static constexpr float THUMBNAIL_SIZE = 48.0f;                    // Beyblade and stadium dropdown images
 
     enum class PopupState {
         NONE,
@@ -101,7 +102,8 @@ private:
     std::shared_ptr<T> drawSection(const std::string& sectionName, const std::string& comboId,
         const std::vector<std::shared_ptr<T>>& items, const std::shared_ptr<T>& activeItem,
         std::function<void(const std::shared_ptr<T>&)> setActiveItem, std::function<std::string(const std::shared_ptr<T>&)> getItemName,
-        std::function<void()> onCreateNew, std::function<void()> onDelete) {
+        std::function<void()> onCreateNew, std::function<void()> onDelete,
+        std::function<void(const std::shared_ptr<T>&)> drawThumbnail = nullptr) {
 
         std::shared_ptr<T> updatedItem = activeItem;
 
@@ -114,7 +116,16 @@ private:
         if (BeginCombo(comboId.c_str(), activeItem ? getItemName(activeItem).c_str() : "None")) {
             for (const auto& item : items) {
                 bool isSelected = (item == activeItem);
-                if (Selectable(getItemName(item).c_str(), isSelected)) {
+                PushID(item.get());
+                ImVec2 itemSize(0, 0);
+                if (drawThumbnail) {
+                    drawThumbnail(item);
+                    SameLine();
+                    itemSize.y = THUMBNAIL_SIZE;
+                }
+                bool clicked = Selectable(getItemName(item).c_str(), isSelected, 0, itemSize);
+                PopID();
+                if (clicked) {
                     updatedItem = item;
                     setActiveItem(item);
                 }
@@ -10,6 +10,7 @@
 #include "StateIdentifiers.h"
 #include "ImGuiUI.h"
 #include "ActiveState.h"
+#include "Thumbnails.h"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -110,10 +111,14 @@ void SelectionState::showPlayerButtons() {
         SeparatorSpacedThick();
         vector<shared_ptr<Beyblade>> currentBeyblades = game->pm.getActiveProfile()->getAllBeyblades();
         for (int i = 0; i < (int)currentBeyblades.size(); ++i) {
-            if (Selectable(currentBeyblades[i]->getName().c_str())) {
+            PushID(i);
+            beybladeThumbnail(*game->thumbnails, *game->objectShader, *currentBeyblades[i], LIST_THUMBNAIL_SIZE);
+            SameLine();
+            if (Selectable(currentBeyblades[i]->getName().c_str(), false, 0, ImVec2(0, LIST_THUMBNAIL_SIZE))) {
                 players.push_back(currentBeyblades[i]);
                 CloseCurrentPopup();
             }
+            PopID();
         }
         EndPopup();
     }
@@ -154,6 +159,7 @@ void SelectionState::showPlayers() {
     Columns(numColumns, nullptr, false);
 
     for (int i = 0; i < numPlayers; ++i) {
+        beybladeThumbnail(*game->thumbnails, *game->objectShader, *players[i], PLAYER_THUMBNAIL_SIZE);
         Text("Name: %s", players[i]->getName().c_str());
         NextColumn();
     }
@@ -78,4 +78,6 @@ private:
 
 
     const int MAX_PLAYERS = 8;
+    static constexpr float LIST_THUMBNAIL_SIZE = 48.0f;
+    static constexpr float PLAYER_THUMBNAIL_SIZE = 96.0f;
 };
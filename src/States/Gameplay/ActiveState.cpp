@@ -1,3 +1,5 @@
+#include <sstream>
+
 #include "ActiveState.h"
 
 #include "GameEngine.h"
@@ -7,12 +9,14 @@
 #include "ObjectShader.h"
 #include "ImGuiUI.h"
 #include "Camera.h"
+#include "DebugRenderer.h"
 #include "InputManager.h"
 #include "GameMessage.h"
 #include "ProfileManager.h"
 #include "TextureManager.h"
 #include "MessageLog.h"
 
+#include "RenderQueue.h"
 #include "Utils.h"
 
 using namespace std;
@@ -57,17 +61,31 @@ void ActiveState::init()
 
     if(!beyblades.empty()) game->camera->setFollowingBey(beyblades[0]->getBody());
     if(!stadiums.empty()) game->camera->setPanningVariables(stadiums[0].get());
+
+    physicsThread = make_unique<PhysicsThread>(physicsWorld);
+    physicsThread->start();
+    snapshot = &physicsThread->getSnapshot();
+    game->camera->setSnapshot(snapshot);
 }
 
 void ActiveState::cleanup()
 {
+    // Stop physics before anything it references goes away
+    physicsThread->stop();
+    game->camera->setSnapshot(nullptr);
+    snapshot = nullptr;
+
     glClearColor(imguiColor[0], imguiColor[1], imguiColor[2], 1.00f);
     delete floor;
 }
 
-void ActiveState::pause() {}
+void ActiveState::pause() {
+    physicsThread->setPaused(true);
+}
 
-void ActiveState::resume() {}
+void ActiveState::resume() {
+    physicsThread->setPaused(false);
+}
 
 void ActiveState::handleEvents() {
     if (game->im.keyJustPressed(GLFW_KEY_TAB)) {
@@ -103,6 +121,17 @@ void ActiveState::handleEvents() {
             game->projection);
         std::cout << "Left mouse button clicked! Ray: " << ray_world[0] << ", "
             << ray_world[1] << ", " << ray_world[2] << std::endl;
+
+        if (game->debugMode) {
+            for (const Stadium* stadium : game->physicsWorld->getStadiums()) {
+                TriangleBVH::Hit hit;
+                if (stadium->raycast(game->camera->position, ray_world, 100.0f, hit)) {
+                    ostringstream oss;
+                    oss << "Hit " << stadium->getName() << " at " << hit.point.x << ", " << hit.point.y << ", " << hit.point.z;
+                    game->ml.addMessage(oss.str(), MessageType::NORMAL);
+                }
+            }
+        }
     }
 
     // RIght click + drag to move camera
@@ -122,8 +151,10 @@ void ActiveState::handleEvents() {
 
 void ActiveState::onResize(int width, int height) {}
 
+// Physics itself is stepped by physicsThread at a fixed rate, independent of the frame rate
 void ActiveState::update(float deltaTime) {
-    game->physicsWorld->update(deltaTime);
+    snapshot = &physicsThread->getSnapshot();
+    game->camera->setSnapshot(snapshot);
 }
 
 
@@ -158,12 +189,23 @@ void ActiveState::draw() {
     objectShader->setGlobalRenderParams(view, game->projection, cameraPos);
 
 
-    floor->render(*game->objectShader, tm.getTexture("floor").get());
+    // Sorted by state and culled before anything is drawn
+    RenderQueue& renderQueue = *game->renderQueue;
+    renderQueue.begin(view, game->projection, cameraPos);
+
+    floor->submit(renderQueue, *objectShader, tm.getTexture("floor").get());
 
+    float pixelScale = getProjectionPixelScale(game->projection, game->windowHeight);
     for (const std::shared_ptr<Stadium>& stadium : stadiums) {
-        stadium->render(*objectShader);
+        stadium->submit(renderQueue, *objectShader, cameraPos, pixelScale);
+    }
+    for (const shared_ptr<Beyblade>& beyblade : beyblades) {
+        const BodySnapshot* bodySnapshot = snapshot->find(beyblade->getBody());
+        if (bodySnapshot != nullptr) beyblade->render(beybladeBatch, bodySnapshot->center);
     }
-    for (const shared_ptr<Beyblade> beyblade : beyblades) beyblade->render(*objectShader);
+    beybladeBatch.submit(renderQueue, *objectShader);
+
+    renderQueue.flush();
 
 
     // Render the position
@@ -175,7 +217,8 @@ void ActiveState::draw() {
     std::string positionText = ss.str();
 
     if (game->debugMode) {
-        game->physicsWorld->renderDebug(*objectShader);
+        game->physicsWorld->renderDebug(*game->debugRenderer, snapshot);
+        game->debugRenderer->flush(game->projection * view);
     }
 
     if (showInfoScreen) {
@@ -219,27 +262,32 @@ void ActiveState::drawInfoScreen() {
 
     for (const shared_ptr<Beyblade>& beyblade : beyblades) {
         BeybladeBody* beybladeBody = beyblade->getBody();
+        const BodySnapshot* bodySnapshot = snapshot->find(beybladeBody);
+        if (bodySnapshot == nullptr) continue;
+
         if (ImGui::CollapsingHeader(beyblade->getName().data())) {
             ImGui::Text("Velocity");
-            vec3 initialVelocity = beybladeBody->getVelocity().value();
+            vec3 initialVelocity = bodySnapshot->velocity;
             ImGui::SliderFloat("X##V", &initialVelocity.x, -100.0f, 100.0f);
             ImGui::SliderFloat("Y##V", &initialVelocity.y, -100.0f, 100.0f);
             ImGui::SliderFloat("Z##V", &initialVelocity.z, -100.0f, 100.0f);
 
             ImGui::Text("Center");
-            vec3 initialCenter = beybladeBody->getCenter().value();
+            vec3 initialCenter = bodySnapshot->center;
             ImGui::SliderFloat("X##CTR", &initialCenter.x, -100.0f, 100.0f);
             ImGui::SliderFloat("Y##CTR", &initialCenter.y, -100.0f, 100.0f);
             ImGui::SliderFloat("Z##CTR", &initialCenter.z, -100.0f, 100.0f);
 
             ImGui::Text("Angular Velocity");
-            vec3 initialAngularVelocity = beybladeBody->getAngularVelocity().value();
+            vec3 initialAngularVelocity = bodySnapshot->angularVelocity;
             ImGui::SliderFloat("X##AV", &initialAngularVelocity.x, -100.0f, 100.0f);
             ImGui::SliderFloat("Y##AV", &initialAngularVelocity.y, -100.0f, 100.0f);
             ImGui::SliderFloat("Z##AV", &initialAngularVelocity.z, -100.0f, 100.0f);
 
             if (ImGui::Button("Apply Launch Settings")) {
-                beybladeBody->setInitialLaunch(Vec3_M(initialCenter), initialVelocity, initialAngularVelocity);
+                physicsThread->post([=](PhysicsWorld&) {
+                    beybladeBody->setInitialLaunch(Vec3_M(initialCenter), initialVelocity, initialAngularVelocity);
+                });
             }
         }
     }
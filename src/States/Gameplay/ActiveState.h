@@ -5,6 +5,8 @@
 #include "Beyblade.h"
 #include "QuadRenderer.h"
 #include "Floor.h"
+#include "PhysicsThread.h"
+#include "InstanceBatch.h"
 
 class ActiveState : public GameState {
 public:
@@ -44,5 +46,11 @@ private:
     std::vector<std::shared_ptr<Beyblade>> beyblades; // Shared ownership of beyblades
     std::shared_ptr<PhysicsWorld> physicsWorld;       // Shared ownership of physics world
 
+    InstanceBatch beybladeBatch;                      // Beyblades are drawn with one call per mesh
+
+    // Physics runs on its own thread while this state is active; rendering only reads the latest snapshot
+    std::unique_ptr<PhysicsThread> physicsThread;
+    const PhysicsSnapshot* snapshot{};                // Refreshed once per frame in update()
+
     void drawInfoScreen();
 };
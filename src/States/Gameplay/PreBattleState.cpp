@@ -7,6 +7,7 @@
 #include "ObjectShader.h"
 #include "ImGuiUI.h"
 #include "Camera.h"
+#include "DebugRenderer.h"
 #include "InputManager.h"
 #include "GameMessage.h"
 #include "ProfileManager.h"
@@ -14,6 +15,7 @@
 #include "MessageLog.h"
 
 #include "InteractiveBehavior.h"
+#include "RenderQueue.h"
 #include "Utils.h"
 
 using namespace std;
@@ -50,15 +52,20 @@ void PreBattleState::init()
         zmax = std::max(zmax, z + r);
         ymin = std::min(ymin, y);
     }
+    launchSettings.clear();
     for (shared_ptr<Beyblade> beyblade : beyblades) {
         beyblade->getBody()->resetPhysics(Vec3_M(0.0f, 1.0f, 0.0f));
         physicsWorld->addBeyblade(beyblade.get());
+        launchSettings.push_back({ vec3(0.0f, 1.0f, 0.0f), vec3(0.0f), vec3(0.0f) });
     }
+    trajectoryPredictor.invalidate();
 }
 
 void PreBattleState::cleanup()
 {
-   
+    if (launchOptimizer) launchOptimizer->cancel();
+    if (launchSearch.valid()) launchSearch.wait();
+    launchOptimizer.reset();
 }
 
 void PreBattleState::pause() {}
@@ -128,6 +135,11 @@ void PreBattleState::handleEvents() {
             // New beyblade center preserves the initial drag offset.
             glm::vec3 newBeybladePos = currentIntersection + dragOffset;
             heldBeyblade->getBody()->setCenter(newBeybladePos);
+
+            // Dragging sets where the beyblade will be launched from
+            for (size_t i = 0; i < beyblades.size(); ++i) {
+                if (beyblades[i].get() == heldBeyblade) launchSettings[i].center = newBeybladePos;
+            }
         }
     }
 
@@ -170,6 +182,16 @@ void PreBattleState::onResize(int width, int height) {}
 
 void PreBattleState::update(float deltaTime) {
     game->physicsWorld->update(deltaTime);
+
+    if (launchSearch.valid() && launchSearch.wait_for(chrono::seconds(0)) == future_status::ready) {
+        finishLaunchSearch();
+    }
+
+    if (showTrajectory) {
+        trajectoryPredictor.setHorizon(trajectorySeconds);
+        trajectoryPredictor.setLaunches(*game->physicsWorld, launchSettings);
+        trajectoryPredictor.advance(trajectoryBudgetMs);
+    }
 }
 
 
@@ -204,12 +226,22 @@ void PreBattleState::draw() {
     objectShader->setGlobalRenderParams(view, game->projection, cameraPos);
 
 
-    floor->render(*game->objectShader, tm.getTexture("floor").get());
+    // Sorted by state and culled before anything is drawn
+    RenderQueue& renderQueue = *game->renderQueue;
+    renderQueue.begin(view, game->projection, cameraPos);
+
+    floor->submit(renderQueue, *objectShader, tm.getTexture("floor").get());
 
+    float pixelScale = getProjectionPixelScale(game->projection, game->windowHeight);
     for (const std::shared_ptr<Stadium>& stadium : stadiums) {
-        stadium->render(*objectShader);
+        stadium->submit(renderQueue, *objectShader, cameraPos, pixelScale);
+    }
+    for (const shared_ptr<Beyblade>& beyblade : beyblades) {
+        beyblade->render(beybladeBatch, beyblade->getBody()->getCenter().value());
     }
-    for (const shared_ptr<Beyblade> beyblade : beyblades) beyblade->render(*objectShader);
+    beybladeBatch.submit(renderQueue, *objectShader);
+
+    renderQueue.flush();
 
 
     // Render the position
@@ -221,8 +253,12 @@ void PreBattleState::draw() {
     std::string positionText = ss.str();
 
     if (game->debugMode) {
-        game->physicsWorld->renderDebug(*objectShader);
+        game->physicsWorld->renderDebug(*game->debugRenderer);
+    }
+    if (showTrajectory) {
+        drawTrajectories();
     }
+    game->debugRenderer->flush(game->projection * view);
 
     if (showInfoScreen) {
         drawInfoScreen();
@@ -263,33 +299,50 @@ void PreBattleState::drawInfoScreen() {
 
     ImGui::Separator();
 
-    for (const shared_ptr<Beyblade>& beyblade : beyblades) {
-        BeybladeBody* beybladeBody = beyblade->getBody();
+    for (size_t i = 0; i < beyblades.size(); ++i) {
+        const shared_ptr<Beyblade>& beyblade = beyblades[i];
+        LaunchParameters& launch = launchSettings[i];
+        ImGui::PushID(int(i));
         if (ImGui::CollapsingHeader(beyblade->getName().data())) {
             ImGui::Text("Velocity");
-            vec3 initialVelocity = beybladeBody->getVelocity().value();
-            ImGui::SliderFloat("X##V", &initialVelocity.x, -100.0f, 100.0f);
-            ImGui::SliderFloat("Y##V", &initialVelocity.y, -100.0f, 100.0f);
-            ImGui::SliderFloat("Z##V", &initialVelocity.z, -100.0f, 100.0f);
+            ImGui::SliderFloat("X##V", &launch.velocity.x, -100.0f, 100.0f);
+            ImGui::SliderFloat("Y##V", &launch.velocity.y, -100.0f, 100.0f);
+            ImGui::SliderFloat("Z##V", &launch.velocity.z, -100.0f, 100.0f);
 
             ImGui::Text("Center");
-            vec3 initialCenter = beybladeBody->getCenter().value();
-            ImGui::SliderFloat("X##CTR", &initialCenter.x, -100.0f, 100.0f);
-            ImGui::SliderFloat("Y##CTR", &initialCenter.y, -100.0f, 100.0f);
-            ImGui::SliderFloat("Z##CTR", &initialCenter.z, -100.0f, 100.0f);
+            ImGui::SliderFloat("X##CTR", &launch.center.x, -100.0f, 100.0f);
+            ImGui::SliderFloat("Y##CTR", &launch.center.y, -100.0f, 100.0f);
+            ImGui::SliderFloat("Z##CTR", &launch.center.z, -100.0f, 100.0f);
 
             ImGui::Text("Angular Velocity");
-            vec3 initialAngularVelocity = beybladeBody->getAngularVelocity().value();
-            ImGui::SliderFloat("X##AV", &initialAngularVelocity.x, -100.0f, 100.0f);
-            ImGui::SliderFloat("Y##AV", &initialAngularVelocity.y, -100.0f, 100.0f);
-            ImGui::SliderFloat("Z##AV", &initialAngularVelocity.z, -100.0f, 100.0f);
+            ImGui::SliderFloat("X##AV", &launch.angularVelocity.x, -100.0f, 100.0f);
+            ImGui::SliderFloat("Y##AV", &launch.angularVelocity.y, -100.0f, 100.0f);
+            ImGui::SliderFloat("Z##AV", &launch.angularVelocity.z, -100.0f, 100.0f);
 
             if (ImGui::Button("Apply Launch Settings")) {
-                beybladeBody->setInitialLaunch(Vec3_M(initialCenter), initialVelocity, initialAngularVelocity);
+                beyblade->getBody()->setInitialLaunch(Vec3_M(launch.center), launch.velocity, launch.angularVelocity);
+            }
+
+            // Only a one on one matchup can be optimized
+            if (beyblades.size() == 2 && !stadiums.empty()) {
+                if (!launchSearch.valid()) {
+                    ImGui::SameLine();
+                    if (ImGui::Button("Find Best Launch")) startLaunchSearch(i);
+                }
+                else if (launchSearchIndex == i) {
+                    ImGui::Text("Searching: generation %d of %d, %d matches", launchOptimizer->getGeneration() + 1,
+                        launchSearchOptions.generations, int(launchOptimizer->getMatchCount()));
+                    ImGui::SameLine();
+                    if (ImGui::Button("Cancel")) launchOptimizer->cancel();
+                }
             }
         }
+        ImGui::PopID();
     }
 
+    ImGui::Checkbox("Show Predicted Path", &showTrajectory);
+    ImGui::SliderFloat("Prediction Seconds", &trajectorySeconds, 0.5f, 10.0f);
+
     if (ImGui::Button("Launch")) {
 
     }
@@ -311,4 +364,67 @@ void PreBattleState::drawInfoScreen() {
     }
 
     ImGui::End();
-}
\ No newline at end of file
+}
+
+
+/**
+* Start searching for the launch that best beats the other beyblade's current launch settings.
+* Runs on the optimizer's worker threads; update() picks up the result.
+*
+* @param index                  [in] Index of the beyblade to optimize.
+*/
+
+void PreBattleState::startLaunchSearch(size_t index) {
+    size_t other = 1 - index;
+    const Stadium& stadium = *stadiums[0];
+    vec3 stadiumCenter = stadium.getCenter().value();
+    float radius = stadium.getRadius().value();
+    const LaunchParameters& current = launchSettings[index];
+
+    // Centers stay inside the stadium at the current height; velocities span the slider ranges
+    LaunchSearchBounds bounds;
+    bounds.min = { vec3(stadiumCenter.x - 0.8f * radius, current.center.y, stadiumCenter.z - 0.8f * radius), vec3(-100.0f), vec3(-100.0f) };
+    bounds.max = { vec3(stadiumCenter.x + 0.8f * radius, current.center.y, stadiumCenter.z + 0.8f * radius), vec3(100.0f), vec3(100.0f) };
+
+    OpponentLaunches opponents;
+    opponents.mean = launchSettings[other];
+    opponents.spread = { vec3(0.1f * radius, 0.0f, 0.1f * radius), abs(opponents.mean.velocity) * 0.2f + vec3(0.5f, 0.0f, 0.5f),
+        abs(opponents.mean.angularVelocity) * 0.1f };
+
+    launchOptimizer = make_unique<LaunchOptimizer>(*game->physicsWorld, *beyblades[index]->getBody(), *beyblades[other]->getBody(), stadium);
+    launchSearchIndex = index;
+    launchSearch = async(std::launch::async, [this, current, bounds, opponents]() {
+        return launchOptimizer->optimize(current, bounds, opponents, launchSearchOptions);
+    });
+}
+
+void PreBattleState::finishLaunchSearch() {
+    LaunchEvaluation best = launchSearch.get();
+    bool cancelled = launchOptimizer->wasCancelled();
+    launchOptimizer.reset();
+
+    // Partial results are not worth applying, the last generation may not have finished
+    if (cancelled) {
+        game->ml.addMessage("Launch search for " + beyblades[launchSearchIndex]->getName() + " cancelled", MessageType::NORMAL, true);
+        return;
+    }
+
+    launchSettings[launchSearchIndex] = best.launch;
+    ostringstream ss;
+    ss << "Best launch for " << beyblades[launchSearchIndex]->getName() << ": " << best.wins << " wins, " << best.losses
+        << " losses, " << best.draws << " draws (" << std::fixed << std::setprecision(0) << 100.0f * best.winRate << "%)";
+    game->ml.addMessage(ss.str(), MessageType::NORMAL, true);
+}
+
+
+/**
+* Add the predicted path of each beyblade to the frame's debug lines, so it is depth tested against the scene.
+*/
+
+void PreBattleState::drawTrajectories() {
+    static const vec3 colors[] = { vec3(1.0f, 0.78f, 0.16f), vec3(0.16f, 0.78f, 1.0f), vec3(1.0f, 0.31f, 0.78f), vec3(0.47f, 1.0f, 0.31f) };
+
+    for (size_t b = 0; b < trajectoryPredictor.getPathCount(); ++b) {
+        game->debugRenderer->addPath(trajectoryPredictor.getPath(b), colors[b % 4]);
+    }
+}
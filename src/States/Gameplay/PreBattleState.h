@@ -1,10 +1,16 @@
 #pragma once
 
+#include <future>
+#include <memory>
+
 #include "GameState.h"
 #include "Stadium.h"
 #include "Beyblade.h"
 #include "QuadRenderer.h"
 #include "Floor.h"
+#include "TrajectoryPredictor.h"
+#include "LaunchOptimizer.h"
+#include "InstanceBatch.h"
 
 class PreBattleState : public GameState {
 public:
@@ -49,5 +55,25 @@ private:
     glm::vec3 dragOffset;
     const float stadiumY = 0.0f;
 
+    InstanceBatch beybladeBatch;
+
+    // Launch settings edited by the menu, one per beyblade. Applied to the bodies by "Apply Launch Settings".
+    std::vector<LaunchParameters> launchSettings;
+
+    // Predicted path for the current launch settings
+    TrajectoryPredictor trajectoryPredictor;
+    bool showTrajectory = true;
+    float trajectorySeconds = 3.0f;
+    const float trajectoryBudgetMs = 2.0f;          // Wall time per frame spent on the prediction
+
+    // Background search for the best launch of one beyblade against the other
+    std::unique_ptr<LaunchOptimizer> launchOptimizer;
+    std::future<LaunchEvaluation> launchSearch;
+    size_t launchSearchIndex = 0;
+    LaunchOptimizerOptions launchSearchOptions;
+
     void drawInfoScreen();
+    void drawTrajectories();
+    void startLaunchSearch(size_t index);
+    void finishLaunchSearch();
 };
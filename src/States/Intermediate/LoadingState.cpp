@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <chrono>
 
 #include "LoadingState.h"
@@ -17,7 +18,11 @@ void LoadingState::init() {
     }
     taskThread = std::thread([this]() {
         for (taskIndex = 0; taskIndex < tasks.size(); ++taskIndex) {
-            if (!tasks[taskIndex]()) {
+            auto onProgress = [this](float taskProgress) {
+                std::lock_guard<std::mutex> lock(dataMutex);
+                progress = (taskIndex + std::clamp(taskProgress, 0.0f, 1.0f)) / tasks.size();
+            };
+            if (!tasks[taskIndex](onProgress)) {
                 {
                     std::lock_guard<std::mutex> lock(dataMutex);
                     failed = true;
@@ -52,8 +57,14 @@ void LoadingState::handleEvents() {}
 void LoadingState::onResize(int width, int height) {}
 
 void LoadingState::update(float deltaTime) {
-    if (completed) {
-        onComplete();
+    bool done;
+    {
+        std::lock_guard<std::mutex> lock(dataMutex);
+        done = completed && !failed;    // On failure the player returns with the button instead
+    }
+    if (done) {
+        auto callback = onComplete;     // onComplete may pop (and destroy) this state
+        callback();
     }
 }
 
@@ -7,7 +7,7 @@
 
 class LoadingState : public GameState {
 public:
-    LoadingState(GameEngine* _game, const std::vector<std::function<bool()>>& tasks, std::function<void()> onComplete) :
+    LoadingState(GameEngine* _game, const std::vector<LoadingTask>& tasks, std::function<void()> onComplete) :
         GameState(_game), tasks(tasks), onComplete(onComplete) {};
 
     void init() override;
@@ -52,6 +52,6 @@ private:
 
     std::mutex dataMutex;   // New mutex for protecting shared data
     std::thread taskThread;
-    std::vector<std::function<bool()>> tasks;
+    std::vector<LoadingTask> tasks;
     std::function<void()> onComplete;
 };
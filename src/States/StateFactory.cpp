@@ -51,7 +51,7 @@ namespace StateFactory {
     // Overload that specifically creates a LoadingState
     unique_ptr<GameState> createLoadingState(
         GameEngine* game,
-        const vector<function<bool()>>& tasks,
+        const vector<LoadingTask>& tasks,
         function<void()> onComplete
     ) {
         return make_unique<LoadingState>(game, tasks, onComplete);
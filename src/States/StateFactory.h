@@ -1,5 +1,6 @@
 #pragma once
 
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -9,6 +10,10 @@ class Beyblade;
 
 #include "GameState.h"
 
+// A loading screen task returns false on failure. Long tasks can report their own progress, 0 to 1, through the callback.
+using LoadingProgress = std::function<void(float)>;
+using LoadingTask = std::function<bool(const LoadingProgress&)>;
+
 namespace StateFactory {
     // Static method to create a state based on the GameStateType
     std::unique_ptr<GameState> createState(GameEngine* game, GameStateType stateType);
@@ -24,7 +29,7 @@ namespace StateFactory {
     // Specifically to create differentiable loading states
     std::unique_ptr<GameState> createLoadingState(
         GameEngine* game,
-        const std::vector<std::function<bool()>>& tasks,
+        const std::vector<LoadingTask>& tasks,
         std::function<void()> onComplete
     );
 }
@@ -3,6 +3,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include "ObjectShader.h"
 #include "InputUtils.h"
+#include "Thumbnails.h"
+#include "ThumbnailAtlas.h"
+#include "Utils.h"
 
 using namespace std;
 StadiumPreview::StadiumPreview(int width, int height, PhysicsWorld* physicsWorld, ObjectShader* shader)
@@ -15,11 +18,6 @@ StadiumPreview::StadiumPreview(int width, int height, PhysicsWorld* physicsWorld
         static_cast<float>(width),
         static_cast<float>(height));
     stadium = new Stadium();
-
-    // Re‐generates the stadium mesh every 0.15 seconds so performance is not severly hindered
-    stadiumRenderTimer = std::make_unique<Timer>(0.15f, [this]() {
-        if (stadium) stadium->updateMesh();
-    });
 }
 
 void StadiumPreview::handleInput(float deltaTime) {
@@ -51,9 +49,6 @@ void StadiumPreview::update(float deltaTime, float currentTime) {
     //    stadium = tempStadium; // Safely swap the loaded stadium
     //}
     camera->update(deltaTime);
-    if (stadiumRenderTimer->shouldTrigger(currentTime)) {
-        stadiumRenderTimer->trigger(currentTime);
-    }
 }
 
 void StadiumPreview::draw() {
@@ -66,35 +61,48 @@ void StadiumPreview::draw() {
     //    return;
     //}
 
+    // The FBO keeps the last image, so only render when the stadium or the camera changed
+    uint64_t key = ContentHash()
+        .add(stadium ? getContentKey(*stadium) : 0ull)
+        .add(camera->position)
+        .add(camera->front)
+        .add(camera->zoom)
+        .add(width)
+        .add(height)
+        .get();
+    if (!rendered || key != renderedKey) {
+        renderScene();
+        renderedKey = key;
+        rendered = true;
+    }
+
+    ImGui::BeginChild("StadiumPreview", ImVec2((float)width, (float)height), false, ImGuiWindowFlags_NoScrollbar);
+    hovered = ImGui::IsItemHovered(); // We'll use this in handleInput
+    ImGui::Image((void*)(intptr_t)fbo->getTexture(), ImVec2((float)width, (float)height));
+    ImGui::EndChild();
+}
+
+void StadiumPreview::renderScene() {
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
     fbo->bind();
-    glViewport(0, 0, width, height);
     glEnable(GL_DEPTH_TEST);
-    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
     if (objectShader) {
         objectShader->use();
-        objectShader->setMat4(
-            "projection",
-            glm::perspective(glm::radians(camera->zoom),
-                (float)width / (float)height,
-                0.1f,
-                100.0f)
-        );
-        objectShader->setMat4("view", camera->getViewMatrix());
+        glm::mat4 projection = glm::perspective(glm::radians(camera->zoom),
+            (float)width / (float)height,
+            0.1f,
+            100.0f);
+        objectShader->setGlobalRenderParams(camera->getViewMatrix(), projection, camera->position);
         if (stadium) {
-            stadium->render(*objectShader);
+            stadium->render(*objectShader, camera->position, getProjectionPixelScale(projection, height));
         }
     }
 
     fbo->unbind();
-    // TODO:
-    // Restore main viewport afterwards. Do in cleanup?
-
-    ImGui::BeginChild("StadiumPreview", ImVec2((float)width, (float)height), false, ImGuiWindowFlags_NoScrollbar);
-    hovered = ImGui::IsItemHovered(); // We'll use this in handleInput
-    ImGui::Image((void*)(intptr_t)fbo->getTexture(), ImVec2((float)width, (float)height));
-    ImGui::EndChild();
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
 }
 
 // TODO: Run stadium rendering on separate thread and show loading screen
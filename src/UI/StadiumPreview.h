@@ -1,12 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <glm/glm.hpp>
 #include "BeybladeConstants.h"
 #include "FramebufferRenderer.h"
 #include "Camera.h"
 #include "Stadium.h"
-#include "Timer.h"
 #include <thread>
 #include <mutex>
 
@@ -22,7 +22,7 @@ public:
     void handleInput(float deltaTime);
     void update(float deltaTime, float currentTime);
     //void updateStadiumAsync(Stadium* newStadium);
-    void draw(); // Renders the stadium into an FBO, draws ImGui image
+    void draw(); // Renders the stadium into an FBO when it or the camera changed, draws ImGui image
 
     bool isHovered() const { return hovered; }
     Stadium* getStadium() const { return stadium; }
@@ -41,7 +41,10 @@ private:
     // Internal resources
     std::unique_ptr<FramebufferRenderer> fbo;
     std::unique_ptr<Camera> camera;
-    std::unique_ptr<Timer> stadiumRenderTimer;
+    uint64_t renderedKey = 0;       // Stadium and camera the FBO holds, see draw()
+    bool rendered = false;
+
+    void renderScene();
 
     //std::atomic<bool> isLoading = false; 
     //Stadium* tempStadium;
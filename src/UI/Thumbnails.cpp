@@ -0,0 +1,109 @@
+////////////////////////////////////////////////////////////////////////////////
+// Thumbnails.cpp -- Beyblade and stadium list thumbnails -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+#include <imgui.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Thumbnails.h"
+
+#include "Beyblade.h"
+#include "ObjectShader.h"
+#include "Stadium.h"
+#include "ThumbnailAtlas.h"
+
+using namespace std;
+
+namespace {
+
+constexpr float FOV = 45.0f;
+
+/**
+* Set up the object shader to frame a sphere, seen from slightly above.
+*
+* @param shader                 [in] Object shader.
+* @param center                 [in] Sphere center, world coordinates.
+* @param radius                 [in] Sphere radius.
+* @param direction              [in] From the center towards the camera.
+*
+* @return Camera position.
+*/
+
+glm::vec3 frameSphere(ObjectShader& shader, const glm::vec3& center, float radius, const glm::vec3& direction) {
+    radius = std::max(radius, 0.001f);
+    float distance = radius / sin(glm::radians(FOV / 2.0f));
+    glm::vec3 position = center + glm::normalize(direction) * distance;
+
+    glm::mat4 view = glm::lookAt(position, center, glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(FOV), 1.0f, distance * 0.01f, distance * 10.0f);
+    shader.use();
+    shader.setGlobalRenderParams(view, projection, position);
+    return position;
+}
+
+void showThumbnail(ThumbnailAtlas& atlas, uint64_t key, const ThumbnailAtlas::RenderFunction& render, float size) {
+    glm::vec2 uv0, uv1;
+    if (atlas.get(key, render, uv0, uv1)) {
+        ImGui::Image((void*)(intptr_t)atlas.getTexture(), ImVec2(size, size), ImVec2(uv0.x, uv0.y), ImVec2(uv1.x, uv1.y));
+    }
+    else {
+        ImGui::Dummy(ImVec2(size, size));
+    }
+}
+
+}
+
+uint64_t getContentKey(const Stadium& stadium) {
+    shared_ptr<Texture> texture = stadium.getTexture();
+    return ContentHash()
+        .add(string("stadium"))
+        .add(stadium.getCenter().value())
+        .add(stadium.getRadius().value())
+        .add(stadium.getCurvature().value())
+        .add(stadium.getVerticesPerRing())
+        .add(stadium.getNumRings())
+        .add(stadium.getRingColor())
+        .add(stadium.getCrossColor())
+        .add(stadium.getTint())
+        .add(stadium.getTextureScale())
+        .add(texture ? texture->ID : 0u)    // Changes when a background load finishes
+        .get();
+}
+
+uint64_t getContentKey(Beyblade& beyblade) {
+    ContentHash hash;
+    hash.add(string("beyblade")).add(beyblade.isTemplate);
+    if (beyblade.isTemplate) {
+        hash.add(beyblade.templateIndices[0]).add(beyblade.templateIndices[1]).add(beyblade.templateIndices[2]);
+    }
+    if (BeybladeMesh* mesh = beyblade.getMesh()) {
+        hash.add(mesh->getModelPath()).add(mesh->modelLoaded).add(mesh->tint);
+    }
+    return hash.get();
+}
+
+void stadiumThumbnail(ThumbnailAtlas& atlas, ObjectShader& shader, Stadium& stadium, float size) {
+    showThumbnail(atlas, getContentKey(stadium), [&]() {
+        glm::vec3 center = stadium.getCenter().value();
+        glm::vec3 position = frameSphere(shader, center, stadium.getRadius().value(), glm::vec3(0.0f, 1.0f, 1.2f));
+        stadium.render(shader, position, 0.0f);
+    }, size);
+}
+
+void beybladeThumbnail(ThumbnailAtlas& atlas, ObjectShader& shader, Beyblade& beyblade, float size) {
+    BeybladeMesh* mesh = beyblade.getMesh();
+    if (mesh == nullptr || !mesh->modelLoaded) {
+        ImGui::Dummy(ImVec2(size, size));
+        return;
+    }
+
+    showThumbnail(atlas, getContentKey(beyblade), [&]() {
+        const BoundingBox& box = mesh->boundingBox;
+        glm::vec3 center = (box.min + box.max) * 0.5f;
+        frameSphere(shader, center, glm::length(box.max - box.min) * 0.5f, glm::vec3(1.0f, 0.8f, 1.0f));
+        beyblade.render(shader, glm::vec3(0.0f));
+    }, size);
+}
@@ -0,0 +1,21 @@
+////////////////////////////////////////////////////////////////////////////////
+// Thumbnails.h -- Beyblade and stadium list thumbnails include -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+////////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+
+class Beyblade;
+class ObjectShader;
+class Stadium;
+class ThumbnailAtlas;
+
+// Content keys: equal whenever the object would render the same
+uint64_t getContentKey(const Stadium& stadium);
+uint64_t getContentKey(Beyblade& beyblade);
+
+// Draw an ImGui image of the object from the atlas, or an empty box of the same size while it is being rendered
+void stadiumThumbnail(ThumbnailAtlas& atlas, ObjectShader& shader, Stadium& stadium, float size);
+void beybladeThumbnail(ThumbnailAtlas& atlas, ObjectShader& shader, Beyblade& beyblade, float size);
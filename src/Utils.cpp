@@ -45,6 +45,18 @@ glm::vec3 screenToWorldCoordinates(GLFWwindow* window, float xpos, float ypos, c
     return ray_wor;
 }
 
+/**
+* Pixels covered by one unit at a distance of one unit in front of a perspective camera. Divide by the distance for
+* the on-screen size of an object, e.g. to choose a level of detail.
+*
+* @param projection [in] Perspective projection matrix.
+* @param viewportHeight [in] Viewport height in pixels.
+*/
+
+float getProjectionPixelScale(const glm::mat4& projection, int viewportHeight) {
+    return projection[1][1] * 0.5f * float(viewportHeight);
+}
+
 
 /**
  * Returns true if the ray intersects the axis aligned bounding box.
@@ -26,6 +26,7 @@ void checkGLError(const char* stmt, const char* fname, int line);
 std::string checkIntersection(const glm::vec3 & ray_world);
 void printVec3(const std::string& label, const glm::vec3& v);
 glm::vec3 screenToWorldCoordinates(GLFWwindow * window, float xpos, float ypos, const glm::mat4 & view, const glm::mat4 & projection);
+float getProjectionPixelScale(const glm::mat4 & projection, int viewportHeight);
 bool rayIntersectsAABB(const glm::vec3 & rayOrigin, const glm::vec3 & rayDir, const BoundingBox & box, float& tNear);
 
 
@@ -37,7 +37,7 @@ int main() {
 
     /* ----------------------MAIN RENDERING LOOP-------------------------- */
 
-    //std::function<bool()> wait = { [&]() -> bool { MockLoading::getInstance().mock(); return true; } };
+    //LoadingTask wait = { [&](const LoadingProgress&) -> bool { MockLoading::getInstance().mock(); return true; } };
     //game->pushState(StateFactory::createLoadingState(
     //    game,
     //    {wait, wait, wait},
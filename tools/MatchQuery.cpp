@@ -0,0 +1,137 @@
+////////////////////////////////////////////////////////////////////////////////
+// MatchQuery.cpp -- Command line queries over match result files -- rz -- 2026-10-18
+// Copyright (c) 2024, Ricky Zhang.
+//
+// Usage: MatchQuery <results.bbmr> [column<op>value ...] [--winrate layer|disc|driver <id>] [--print N]
+//
+//   MatchQuery sweep.bbmr "stadiumCurvature>0.2" --winrate driver 3
+//   MatchQuery sweep.bbmr "layer1==2" "duration<5" --print 10
+//
+// Operators: == != < <= > >=. Filters are ANDed; chunks whose min/max rule a filter out are never read.
+////////////////////////////////////////////////////////////////////////////////
+
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "MatchResultStore.h"
+
+using namespace std;
+
+static void printUsage() {
+    cerr << "Usage: MatchQuery <results.bbmr> [column<op>value ...] [--winrate layer|disc|driver <id>] [--print N]" << endl;
+    cerr << "Columns:";
+    for (const ColumnInfo& column : MATCH_COLUMNS) cerr << " " << column.name;
+    cerr << endl;
+}
+
+// Whole argument as an integer; false on junk or overflow
+template <typename T>
+static bool parseInteger(const char* text, T& value) {
+    const char* end = text + strlen(text);
+    from_chars_result result = from_chars(text, end, value);
+    return result.ec == errc() && result.ptr == end;
+}
+
+static void printRow(const MatchResult& row) {
+    for (int c = 0; c < MATCH_COLUMN_COUNT; ++c) {
+        cout << (c ? "," : "") << getMatchColumnValue(row, c);
+    }
+    cout << "\n";
+}
+
+static int reportCorruptFile(const char* path) {
+    cerr << "Error: Match result file " << path << " has a corrupt chunk, query aborted" << endl;
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    vector<MatchPredicate> predicates;
+    string winRatePart;
+    int winRateId = -1;
+    long printLimit = 0;
+
+    for (int i = 2; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--winrate" && i + 2 < argc) {
+            winRatePart = argv[++i];
+            if (!parseInteger(argv[++i], winRateId) || winRateId < 0
+                || (winRatePart != "layer" && winRatePart != "disc" && winRatePart != "driver")) {
+                printUsage();
+                return 1;
+            }
+        }
+        else if (arg == "--print" && i + 1 < argc) {
+            if (!parseInteger(argv[++i], printLimit)) {
+                printUsage();
+                return 1;
+            }
+        }
+        else {
+            MatchPredicate predicate;
+            if (!parseMatchPredicate(arg, predicate)) {
+                cerr << "Error: Could not parse filter \"" << arg << "\"" << endl;
+                printUsage();
+                return 1;
+            }
+            predicates.push_back(predicate);
+        }
+    }
+
+    MatchResultReader reader;
+    if (!reader.open(argv[1])) {
+        cerr << "Error: Could not open match result file " << argv[1] << endl;
+        return 1;
+    }
+
+    auto start = chrono::steady_clock::now();
+    MatchQueryStats stats;
+
+    if (winRateId >= 0) {
+        // The part can be on either side of the match, so run the query once per side.
+        // Mirror matches count once for each side (one win, one loss).
+        size_t wins = 0, losses = 0, draws = 0;
+        for (int side = 0; side < 2; ++side) {
+            vector<MatchPredicate> sidePredicates = predicates;
+            sidePredicates.push_back({ findMatchColumn(winRatePart + to_string(side + 1)), CompareOp::EQ, double(winRateId) });
+
+            MatchQueryStats sideStats = reader.query(sidePredicates, [&](const MatchResult& row) {
+                if (row.outcome < 0) ++draws;
+                else if (row.outcome == side) ++wins;
+                else ++losses;
+            }, { OUTCOME });
+            stats.chunksTotal += sideStats.chunksTotal;
+            stats.chunksSkipped += sideStats.chunksSkipped;
+            stats.rowsScanned += sideStats.rowsScanned;
+            stats.rowsMatched += sideStats.rowsMatched;
+            if (sideStats.failed) return reportCorruptFile(argv[1]);
+        }
+
+        size_t total = wins + losses + draws;
+        cout << winRatePart << " " << winRateId << ": " << total << " matches, " << wins << " wins, "
+            << losses << " losses, " << draws << " draws";
+        if (total > 0) cout << ", win rate " << (100.0 * wins / total) << "%";
+        cout << "\n";
+    }
+    else {
+        long printed = 0;
+        stats = reader.query(predicates, printLimit <= 0 ? function<void(const MatchResult&)>() : [&](const MatchResult& row) {
+            if (printed++ < printLimit) printRow(row);
+        });
+        if (stats.failed) return reportCorruptFile(argv[1]);
+        cout << stats.rowsMatched << " matching rows\n";
+    }
+
+    double elapsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout << "Scanned " << stats.rowsScanned << " rows (" << reader.getRowCount() << " stored), skipped "
+        << stats.chunksSkipped << " of " << stats.chunksTotal << " chunks in " << elapsedMs << " ms" << endl;
+    return 0;
+}